@@ -0,0 +1,30 @@
+/*
+ * Host build configuration of RT-Thread for the uC/OS-II wrapper tests.
+ */
+
+#ifndef __RTTHREAD_CFG_H__
+#define __RTTHREAD_CFG_H__
+
+#ifndef RT_THREAD_PRIORITY_MAX
+#define RT_THREAD_PRIORITY_MAX      32
+#endif
+#ifndef RT_TICK_PER_SECOND                  /* Overridden by the tests for each tick rate              */
+#define RT_TICK_PER_SECOND          1000
+#endif
+#define RT_ALIGN_SIZE               8
+#define RT_NAME_MAX                 16
+
+#define RT_USING_HOOK
+#define RT_USING_IDLE_HOOK
+#define RT_USING_TIMER_SOFT         1
+#define RT_TIMER_THREAD_PRIO        4
+#define RT_TIMER_THREAD_STACK_SIZE  512
+
+#define RT_USING_SEMAPHORE
+#define RT_USING_MUTEX
+#define RT_USING_EVENT
+#define RT_USING_MAILBOX
+#define RT_USING_MESSAGEQUEUE
+#define RT_USING_HEAP
+
+#endif
@@ -0,0 +1,109 @@
+/*
+ * Minimal RT-Thread 3.1.3 declarations for building the uC/OS-II wrapper on a host (tests only).
+ */
+
+#ifndef __RT_DEF_H__
+#define __RT_DEF_H__
+#include <rtconfig.h>
+#include <stddef.h>
+typedef signed char rt_int8_t; typedef signed short rt_int16_t; typedef signed int rt_int32_t;
+typedef unsigned char rt_uint8_t; typedef unsigned short rt_uint16_t; typedef unsigned int rt_uint32_t;
+typedef long long rt_int64_t; typedef unsigned long long rt_uint64_t;
+typedef int rt_bool_t; typedef long rt_base_t; typedef unsigned long rt_ubase_t;
+typedef rt_base_t rt_err_t; typedef rt_uint32_t rt_time_t; typedef rt_uint32_t rt_tick_t;
+typedef rt_base_t rt_flag_t; typedef rt_ubase_t rt_size_t; typedef rt_ubase_t rt_dev_t; typedef rt_base_t rt_off_t;
+#define RT_TRUE 1
+#define RT_FALSE 0
+#define RT_NULL ((void*)0)
+#define RT_TICK_MAX 0xffffffff
+#define RT_EOK 0
+#define RT_ERROR 1
+#define RT_ETIMEOUT 2
+#define RT_EFULL 3
+#define RT_EEMPTY 4
+#define RT_ENOMEM 5
+#define RT_EBUSY 7
+#define RT_EINVAL 10
+#define RT_ALIGN(size, align) (((size) + (align) - 1) & ~((align) - 1))
+#define ALIGN(n) __attribute__((aligned(n)))
+#define SECTION(x) __attribute__((section(x)))
+#define RT_UNUSED __attribute__((unused))
+#define RT_USED __attribute__((used))
+#define rt_inline static __inline
+#define INIT_PREV_EXPORT(fn)
+#define INIT_APP_EXPORT(fn)
+#define INIT_COMPONENT_EXPORT(fn)
+#define RT_OBJECT_HOOK_CALL(func, argv) do { if ((func) != RT_NULL) func argv; } while (0)
+#define RT_ASSERT(x)
+#define RT_KERNEL_MALLOC(sz) rt_malloc(sz)
+#define RT_KERNEL_FREE(ptr) rt_free(ptr)
+struct rt_list_node { struct rt_list_node *next; struct rt_list_node *prev; };
+typedef struct rt_list_node rt_list_t;
+struct rt_object { char name[RT_NAME_MAX]; rt_uint8_t type; rt_uint8_t flag; rt_list_t list; };
+typedef struct rt_object *rt_object_t;
+enum rt_object_class_type { RT_Object_Class_Null = 0, RT_Object_Class_Thread, RT_Object_Class_Semaphore, RT_Object_Class_Mutex, RT_Object_Class_Event, RT_Object_Class_MailBox, RT_Object_Class_MessageQueue, RT_Object_Class_MemHeap, RT_Object_Class_MemPool, RT_Object_Class_Device, RT_Object_Class_Timer, RT_Object_Class_Module, RT_Object_Class_Unknown, RT_Object_Class_Static = 0x80 };
+#define RT_TIMER_FLAG_DEACTIVATED 0x0
+#define RT_TIMER_FLAG_ACTIVATED 0x1
+#define RT_TIMER_FLAG_ONE_SHOT 0x0
+#define RT_TIMER_FLAG_PERIODIC 0x2
+#define RT_TIMER_FLAG_HARD_TIMER 0x0
+#define RT_TIMER_FLAG_SOFT_TIMER 0x4
+#define RT_TIMER_CTRL_SET_TIME 0x0
+#define RT_TIMER_CTRL_GET_TIME 0x1
+#define RT_TIMER_CTRL_SET_ONESHOT 0x2
+#define RT_TIMER_CTRL_SET_PERIODIC 0x3
+#define RT_TIMER_SKIP_LIST_LEVEL 1
+struct rt_timer { struct rt_object parent; rt_list_t row[RT_TIMER_SKIP_LIST_LEVEL]; void (*timeout_func)(void *parameter); void *parameter; rt_tick_t init_tick; rt_tick_t timeout_tick; };
+typedef struct rt_timer *rt_timer_t;
+#define RT_THREAD_INIT 0x00
+#define RT_THREAD_READY 0x01
+#define RT_THREAD_SUSPEND 0x02
+#define RT_THREAD_RUNNING 0x03
+#define RT_THREAD_BLOCK RT_THREAD_SUSPEND
+#define RT_THREAD_CLOSE 0x04
+#define RT_THREAD_STAT_MASK 0x0f
+#define RT_THREAD_CTRL_STARTUP 0x00
+#define RT_THREAD_CTRL_CLOSE 0x01
+#define RT_THREAD_CTRL_CHANGE_PRIORITY 0x02
+#define RT_THREAD_CTRL_INFO 0x03
+struct rt_thread {
+    char name[RT_NAME_MAX]; rt_uint8_t type; rt_uint8_t flags;
+    rt_list_t list; rt_list_t tlist; void *sp; void *entry; void *parameter; void *stack_addr; rt_uint32_t stack_size;
+    rt_err_t error; rt_uint8_t stat; rt_uint8_t current_priority; rt_uint8_t init_priority;
+#if RT_THREAD_PRIORITY_MAX > 32
+    rt_uint8_t number; rt_uint8_t high_mask;
+#endif
+    rt_uint32_t number_mask;
+#if defined(RT_USING_EVENT)
+    rt_uint32_t event_set; rt_uint8_t event_info;
+#endif
+    rt_ubase_t init_tick; rt_ubase_t remaining_tick; struct rt_timer thread_timer;
+    void (*cleanup)(struct rt_thread *tid); rt_uint32_t user_data;
+};
+typedef struct rt_thread *rt_thread_t;
+#define RT_IPC_FLAG_FIFO 0x00
+#define RT_IPC_FLAG_PRIO 0x01
+#define RT_IPC_CMD_UNKNOWN 0x00
+#define RT_IPC_CMD_RESET 0x01
+#define RT_WAITING_FOREVER -1
+#define RT_WAITING_NO 0
+struct rt_ipc_object { struct rt_object parent; rt_list_t suspend_thread; };
+struct rt_semaphore { struct rt_ipc_object parent; rt_uint16_t value; };
+typedef struct rt_semaphore *rt_sem_t;
+struct rt_mutex { struct rt_ipc_object parent; rt_uint16_t value; rt_uint8_t original_priority; rt_uint8_t hold; struct rt_thread *owner; };
+typedef struct rt_mutex *rt_mutex_t;
+#define RT_EVENT_FLAG_AND 0x01
+#define RT_EVENT_FLAG_OR 0x02
+#define RT_EVENT_FLAG_CLEAR 0x04
+struct rt_event { struct rt_ipc_object parent; rt_uint32_t set; };
+typedef struct rt_event *rt_event_t;
+struct rt_messagequeue { struct rt_ipc_object parent; void *msg_pool; rt_uint16_t msg_size; rt_uint16_t max_msgs; rt_uint16_t entry; void *msg_queue_head; void *msg_queue_tail; void *msg_queue_free; };
+typedef struct rt_messagequeue *rt_mq_t;
+struct rt_mailbox { struct rt_ipc_object parent; rt_uint32_t *msg_pool; rt_uint16_t size; rt_uint16_t entry; rt_uint16_t in_offset; rt_uint16_t out_offset; rt_list_t suspend_sender_thread; };
+typedef struct rt_mailbox *rt_mailbox_t;
+#endif
+#define RT_WEAK __attribute__((weak))
+#ifdef RT_USING_SMP
+#define RT_THREAD_CTRL_BIND_CPU 0x04
+int rt_hw_cpu_id(void);
+#endif
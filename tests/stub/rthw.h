@@ -0,0 +1,10 @@
+/*
+ * Minimal RT-Thread 3.1.3 declarations for building the uC/OS-II wrapper on a host (tests only).
+ */
+
+#ifndef __RT_HW_H__
+#define __RT_HW_H__
+#include <rtthread.h>
+rt_base_t rt_hw_interrupt_disable(void);
+void rt_hw_interrupt_enable(rt_base_t level);
+#endif
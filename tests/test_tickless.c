@@ -0,0 +1,196 @@
+/*
+ * Copyright (c) 2021, Meco Jianting Man <jiantingman@foxmail.com>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+/*
+*********************************************************************************************************
+*                                         TICKLESS IDLE HOST TEST
+*
+* Filename : test_tickless.c
+*
+* Note(s)  : 1) Built by the Makefile against a copy of the wrapper with OS_TICKLESS_EN set to 1.  The
+*               RT-Thread tick, timer list, ready lists and the BSP sleep are simulated below.
+*********************************************************************************************************
+*/
+
+#include <stdio.h>
+#include "ucos_ii.h"
+
+/*
+*********************************************************************************************************
+*                                       SIMULATED RT-THREAD / BSP
+*********************************************************************************************************
+*/
+
+rt_list_t           rt_thread_priority_table[RT_THREAD_PRIORITY_MAX];
+rt_uint32_t         rt_thread_ready_priority_group;
+#if RT_THREAD_PRIORITY_MAX > 32
+rt_uint8_t          rt_thread_ready_table[32];
+#endif
+
+static  rt_tick_t   SimTick;                     /* Current tick                                       */
+static  rt_tick_t   SimNext;                     /* First timer expiry, RT_TICK_MAX if none            */
+static  int         SimIntDis;                   /* Interrupt disable nesting                          */
+static  INT32U      SimSleepReq;                 /* Ticks asked for by OS_TicklessIdle(), 0 if no call */
+static  INT32U      SimSleepRet;                 /* Ticks OS_CPU_TicklessSleep() reports as slept      */
+static  int         SimSleepIntDis;              /* Interrupts were disabled during the sleep          */
+static  int         SimTmrChkCtr;                /* Number of calls to rt_timer_check()                */
+static  struct rt_thread  SimIdle;
+static  struct rt_thread  SimStat;
+
+OS_CPU_SR  OS_CPU_SR_Save (void)
+{
+    SimIntDis++;
+    return (0u);
+}
+
+void  OS_CPU_SR_Restore (OS_CPU_SR  cpu_sr)
+{
+    (void)cpu_sr;
+    SimIntDis--;
+}
+
+rt_tick_t  rt_tick_get (void)
+{
+    return (SimTick);
+}
+
+void  rt_tick_set (rt_tick_t tick)
+{
+    SimTick = tick;
+}
+
+rt_tick_t  rt_timer_next_timeout_tick (void)
+{
+    return (SimNext);
+}
+
+void  rt_timer_check (void)
+{
+    SimTmrChkCtr++;
+}
+
+INT32U  OS_CPU_TicklessSleep (INT32U ticks)
+{
+    SimSleepReq    = ticks;
+    SimSleepIntDis = (SimIntDis > 0);
+    return (SimSleepRet);
+}
+
+static  void  SimReset (rt_tick_t now, rt_tick_t next, INT32U slept)
+{
+    INT32U  i;
+
+
+    for (i = 0u; i < RT_THREAD_PRIORITY_MAX; i++) {
+        rt_list_init(&rt_thread_priority_table[i]);
+    }
+    rt_thread_ready_priority_group = 0u;
+#if RT_THREAD_PRIORITY_MAX > 32
+    for (i = 0u; i < 32u; i++) {
+        rt_thread_ready_table[i] = 0u;
+    }
+#endif
+    SimTick        = now;
+    SimNext        = next;
+    SimIntDis      = 0;
+    SimSleepReq    = 0u;
+    SimSleepRet    = slept;
+    SimSleepIntDis = 0;
+    SimTmrChkCtr   = 0;
+}
+
+static  void  SimReady (struct rt_thread *thread, INT32U prio)
+{
+    rt_list_insert_before(&rt_thread_priority_table[prio], &thread->tlist);
+#if RT_THREAD_PRIORITY_MAX > 32
+    rt_thread_ready_priority_group |= 1uL << (prio >> 3);
+    rt_thread_ready_table[prio >> 3] |= (rt_uint8_t)(1u << (prio & 7u));
+#else
+    rt_thread_ready_priority_group |= 1uL << prio;
+#endif
+}
+
+/*
+*********************************************************************************************************
+*                                                 TESTS
+*********************************************************************************************************
+*/
+
+static  int  TestFail;
+
+#define  CHECK(cond)   do { if (!(cond)) { printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond); TestFail = 1; } } while (0)
+
+#define  IDLE_PRIO     (RT_THREAD_PRIORITY_MAX - 1u)
+
+static  void  TestTicks (void)
+{
+    CHECK(OS_TicklessTicks(100u, RT_TICK_MAX) == OS_TIME_DLY_MAX);           /* No timer                   */
+    CHECK(OS_TicklessTicks(0xFFFFFFF0u, RT_TICK_MAX) == OS_TIME_DLY_MAX);
+    CHECK(OS_TicklessTicks(100u, 150u) == 50u);
+    CHECK(OS_TicklessTicks(0xFFFFFFF0u, 0x10u) == 0x20u);                    /* 'next' wrapped around      */
+    CHECK(OS_TicklessTicks(0xFFFFFFFFu, 0xFFFFFFFEu) == 0u);                 /* Due, just before wrap      */
+    CHECK(OS_TicklessTicks(100u, 100u) == 0u);                               /* Due now                    */
+    CHECK(OS_TicklessTicks(100u, 99u) == 0u);                                /* Overdue                    */
+    CHECK(OS_TicklessTicks(5u, 0xFFFFFFFBu) == 0u);                          /* Overdue across the wrap    */
+    CHECK(OS_TicklessTicks(100u, 100u + OS_TICKLESS_MIN_TICKS - 1u) == 0u);  /* Below the cutoff           */
+    CHECK(OS_TicklessTicks(100u, 100u + OS_TICKLESS_MIN_TICKS) == OS_TICKLESS_MIN_TICKS);
+    CHECK(OS_TicklessTicks(100u, 100u + OS_TIME_DLY_MAX) == OS_TIME_DLY_MAX); /* Farthest future timer     */
+    CHECK(OS_TicklessTicks(100u, 100u + OS_TIME_DLY_MAX + 1u) == 0u);         /* Half a period away: due   */
+}
+
+static  void  TestIdle (void)
+{
+    SimReset(0xFFFFFFF8u, 0x2u, 10u);            /* Only the idle thread is ready: sleep until the timer */
+    SimReady(&SimIdle, IDLE_PRIO);
+    OS_TicklessIdle();
+    CHECK(SimSleepReq == 10u);
+    CHECK(SimSleepIntDis == 1);
+    CHECK(SimTick == 0x2u);
+    CHECK(SimTmrChkCtr == 1);
+    CHECK(SimIntDis == 0);
+
+    SimReset(1000u, RT_TICK_MAX, 3u);            /* Woken up early by an interrupt                       */
+    SimReady(&SimIdle, IDLE_PRIO);
+    OS_TicklessIdle();
+    CHECK(SimSleepReq == OS_TIME_DLY_MAX);
+    CHECK(SimTick == 1003u);
+    CHECK(SimIntDis == 0);
+
+    SimReset(1000u, 1100u, 0u);                  /* Nothing slept: no tick accounting                    */
+    SimReady(&SimIdle, IDLE_PRIO);
+    OS_TicklessIdle();
+    CHECK(SimSleepReq == 100u);
+    CHECK(SimTick == 1000u);
+    CHECK(SimTmrChkCtr == 0);
+
+    SimReset(1000u, 1100u, 100u);                /* Statistic task shares the idle priority              */
+    SimReady(&SimIdle, IDLE_PRIO);
+    SimReady(&SimStat, IDLE_PRIO);
+    OS_TicklessIdle();
+    CHECK(SimSleepReq == 0u);
+    CHECK(SimTick == 1000u);
+    CHECK(SimIntDis == 0);
+
+    SimReset(1000u, 1100u, 100u);                /* A higher priority thread is ready                    */
+    SimReady(&SimIdle, IDLE_PRIO);
+    SimReady(&SimStat, 10u);
+    OS_TicklessIdle();
+    CHECK(SimSleepReq == 0u);
+    CHECK(SimIntDis == 0);
+
+    SimReset(1000u, 1001u, 1u);                  /* Timer too close                                      */
+    SimReady(&SimIdle, IDLE_PRIO);
+    OS_TicklessIdle();
+    CHECK(SimSleepReq == 0u);
+    CHECK(SimIntDis == 0);
+}
+
+int  main (void)
+{
+    TestTicks();
+    TestIdle();
+    printf("test_tickless: %s\n", TestFail ? "FAIL" : "ok");
+    return (TestFail);
+}
@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2021, Meco Jianting Man <jiantingman@foxmail.com>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+/*
+*********************************************************************************************************
+*                                 MILLISECOND / MICROSECOND TIMEOUT HOST TEST
+*
+* Filename : test_time_ms.c
+*
+* Note(s)  : 1) Built by the Makefile once per tick rate (RT_TICK_PER_SECOND = 100, 1000 and 10000).
+*            2) OS_MsToTicks() and OS_UsToTicks() are checked against a few hand computed values and
+*               against a 64-bit reference (round up, saturate to OS_TIME_DLY_MAX).
+*********************************************************************************************************
+*/
+
+#include <stdio.h>
+#include "ucos_ii.h"
+
+static  int  TestFail;
+
+#define  CHECK(cond)   do { if (!(cond)) { printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond); TestFail = 1; } } while (0)
+
+static  INT32U  RefToTicks (INT32U  t, INT64U  units_per_sec)
+{
+    INT64U  ticks;
+
+
+    ticks = ((INT64U)t * OS_TICKS_PER_SEC + units_per_sec - 1u) / units_per_sec;
+    if (ticks > OS_TIME_DLY_MAX) {
+        ticks = OS_TIME_DLY_MAX;
+    }
+    return ((INT32U)ticks);
+}
+
+static  void  TestValues (void)
+{
+    CHECK(OS_MsToTicks(0u) == 0u);                                   /* No delay / wait forever stays 0 */
+    CHECK(OS_UsToTicks(0u) == 0u);
+    CHECK(OS_UsToTicks(1u) == 1u);                                   /* Never shorter than asked for    */
+#if   OS_TICKS_PER_SEC == 100u
+    CHECK(OS_MsToTicks(1u)  == 1u);                                  /* Rounded up to a whole tick      */
+    CHECK(OS_MsToTicks(10u) == 1u);
+    CHECK(OS_MsToTicks(11u) == 2u);
+    CHECK(OS_UsToTicks(10000u) == 1u);
+    CHECK(OS_UsToTicks(10001u) == 2u);
+    CHECK(OS_MsToTicks(0xFFFFFFFFu) == 429496730u);                  /* Largest 'ms', no overflow       */
+    CHECK(OS_UsToTicks(0xFFFFFFFFu) == 429497u);
+#elif OS_TICKS_PER_SEC == 1000u
+    CHECK(OS_MsToTicks(1u)  == 1u);
+    CHECK(OS_MsToTicks(1234u) == 1234u);
+    CHECK(OS_UsToTicks(999u)  == 1u);
+    CHECK(OS_UsToTicks(1001u) == 2u);
+    CHECK(OS_MsToTicks(OS_TIME_DLY_MAX) == OS_TIME_DLY_MAX);
+    CHECK(OS_MsToTicks(OS_TIME_DLY_MAX + 1u) == OS_TIME_DLY_MAX);    /* Saturated                       */
+    CHECK(OS_MsToTicks(0xFFFFFFFFu) == OS_TIME_DLY_MAX);
+    CHECK(OS_UsToTicks(0xFFFFFFFFu) == 4294968u);
+#elif OS_TICKS_PER_SEC == 10000u
+    CHECK(OS_MsToTicks(1u)  == 10u);
+    CHECK(OS_UsToTicks(100u) == 1u);
+    CHECK(OS_UsToTicks(101u) == 2u);
+    CHECK(OS_MsToTicks(OS_TIME_DLY_MAX / 10u) == (OS_TIME_DLY_MAX / 10u) * 10u);
+    CHECK(OS_MsToTicks(OS_TIME_DLY_MAX / 10u + 1u) == OS_TIME_DLY_MAX);  /* Saturated                   */
+    CHECK(OS_MsToTicks(0xFFFFFFFFu) == OS_TIME_DLY_MAX);
+    CHECK(OS_UsToTicks(0xFFFFFFFFu) == 42949673u);
+#endif
+}
+
+static  void  TestSweep (void)
+{
+    static  const  INT32U  t[] = {0u, 1u, 2u, 9u, 10u, 11u, 99u, 100u, 101u, 999u, 1000u, 1001u,
+                                  123456u, 999999u, 1000000u, 1000001u, 214748364u, 214748365u,
+                                  0x7FFFFFFEu, 0x7FFFFFFFu, 0x80000000u, 0xFFFFFFFEu, 0xFFFFFFFFu};
+    INT32U  i;
+
+
+    for (i = 0u; i < sizeof(t) / sizeof(t[0]); i++) {
+        if (OS_MsToTicks(t[i]) != RefToTicks(t[i], 1000u)) {
+            printf("FAIL OS_MsToTicks(%lu) = %lu, expected %lu\n", (unsigned long)t[i],
+                   (unsigned long)OS_MsToTicks(t[i]), (unsigned long)RefToTicks(t[i], 1000u));
+            TestFail = 1;
+        }
+        if (OS_UsToTicks(t[i]) != RefToTicks(t[i], 1000000u)) {
+            printf("FAIL OS_UsToTicks(%lu) = %lu, expected %lu\n", (unsigned long)t[i],
+                   (unsigned long)OS_UsToTicks(t[i]), (unsigned long)RefToTicks(t[i], 1000000u));
+            TestFail = 1;
+        }
+    }
+}
+
+int  main (void)
+{
+    TestValues();
+    TestSweep();
+    printf("test_time_ms (%lu Hz): %s\n", (unsigned long)OS_TICKS_PER_SEC, TestFail ? "FAIL" : "ok");
+    return (TestFail);
+}
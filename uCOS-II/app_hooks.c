@@ -137,6 +137,27 @@ void  App_TaskDelHook (OS_TCB *ptcb)
 }
 
 
+/*
+*********************************************************************************************************
+*                                TASK DEADLINE MISS HOOK (APPLICATION)
+*
+* Description : This function is called by OSTaskDeadlineMissHook() when a periodic task completed a cycle
+*               after its deadline.
+*
+* Argument(s) : ptcb   is a pointer to the task control block of the late task.
+*
+* Note(s)     : (1) Interrupts are enabled during this call.
+*********************************************************************************************************
+*/
+
+#if OS_TASK_PERIODIC_EN > 0u
+void  App_TaskDeadlineMissHook (OS_TCB *ptcb)
+{
+    (void)ptcb;
+}
+#endif
+
+
 #if OS_TASK_STAT_EN > 0u
 /*
 *********************************************************************************************************
@@ -176,6 +197,34 @@ void  App_TaskStatHook (void)
 #endif
 
 
+/*
+*********************************************************************************************************
+*                                   TASK SWITCH HOOK (APPLICATION)
+*
+* Description : This function is called when a task switch is performed.  This allows you to perform other
+*               operations during a context switch.
+*
+* Argument(s) : ptcb_cur        is a pointer to the TCB of the task being switched out.
+*
+*               ptcb_high_rdy   is a pointer to the TCB of the task being switched in.
+*
+* Note(s)     : (1) Interrupts are disabled during this call.
+*
+*               (2) OSTCBCur already refers to the task being switched in, use the arguments instead.
+*
+*               (3) Either pointer is NULL when the thread was not created through uC/OS-II.
+*********************************************************************************************************
+*/
+
+#if OS_TASK_SW_HOOK_EN > 0u
+void  App_TaskSwHook (OS_TCB *ptcb_cur, OS_TCB *ptcb_high_rdy)
+{
+    (void)ptcb_cur;
+    (void)ptcb_high_rdy;
+}
+#endif
+
+
 /*
 *********************************************************************************************************
 *                                   OS_TCBInit() HOOK (APPLICATION)
@@ -196,4 +245,23 @@ void  App_TCBInitHook (OS_TCB *ptcb)
 }
 #endif
 
+
+/*
+*********************************************************************************************************
+*                                       TICK HOOK (APPLICATION)
+*
+* Description : This function is called every tick.
+*
+* Argument(s) : none.
+*
+* Note(s)     : (1) This function is assumed to be called from the Tick ISR.
+*********************************************************************************************************
+*/
+
+#if OS_TIME_TICK_HOOK_EN > 0u
+void  App_TimeTickHook (void)
+{
+}
+#endif
+
 #endif
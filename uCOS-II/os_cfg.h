@@ -52,7 +52,12 @@
 #define OS_EVENT_MULTI_EN         0u   /* 只读 Include code for OSEventPendMulti()                     */
 #define OS_EVENT_NAME_EN          0u   /* 只读 Enable names for Sem, Mutex, Mbox and Q                      */
 
+#define OS_PRIO_MAP_EN            0u   /* Map OS_LOWEST_PRIO+1 priorities onto RT_THREAD_PRIORITY_MAX  */
+#if OS_PRIO_MAP_EN > 0u
+#define OS_LOWEST_PRIO           63u   /* 读写 Defines the lowest priority that can be assigned ...    */
+#else
 #define OS_LOWEST_PRIO    RT_THREAD_PRIORITY_MAX /* 只读 Defines the lowest priority that can be assigned...*/
+#endif
                                        /* ... MUST NEVER be higher than 254!                           */
 
 #define OS_MAX_MEM_PART           5u   /* Max. number of memory partitions                             */
@@ -60,20 +65,51 @@
 
 #define OS_SCHED_LOCK_EN          1u   /* Include code for OSSchedLock() and OSSchedUnlock()           */
 
+#define OS_START_DEFER_EN         0u   /* Tasks created before OSStart() are started by OSStart()      */
+
+#define OS_TICKLESS_EN            0u   /* Stop the tick while idle (BSP provides OS_CPU_TicklessSleep())*/
+#define OS_TICKLESS_MIN_TICKS     2u   /* Min. idle time (in ticks) worth stopping the tick for        */
+
 #define OS_TICKS_PER_SEC  RT_TICK_PER_SECOND /* 只读 Set the number of ticks in one second             */
 
-#define OS_TLS_TBL_SIZE           0u   /* Size of Thread-Local Storage Table                           */
+#define OS_TLS_TBL_SIZE           4u   /* Size of Thread-Local Storage Table                           */
+#define OS_TLS_LIB_EN             0u   /*     Per-task C library context (newlib) kept in a TLS slot   */
 
 
                                        /* --------------------- TASK STACK SIZE ---------------------- */
 #define OS_TASK_STAT_STK_SIZE   128u   /* Statistics task stack size (# of OS_STK wide entries)        */
+#define OS_TASK_CREATE_STK_SIZE   0u   /* Size assumed for unregistered stacks, 0 == must register     */
+#define OS_TASK_STK_REG_MAX       8u   /* Max. number of stacks registered with OSTaskStkRegister()    */
+#define OS_TASK_STK_CHK_WINDOW    0u   /* # of entries OSTaskStkChk() scans from stack bottom, 0 == all*/
+#define OS_TASK_LITE_STK_SIZE   256u   /* Lite task dispatcher stack size (# of OS_STK wide entries)   */
 
                                        /* --------------------- TASK MANAGEMENT ---------------------- */
+#ifdef RT_USING_SMP                    /* 是否开启由RT-Thread接管                                      */
+#define OS_TASK_AFFINITY_EN       1u   /* 读写 Include code for OSTaskAffinitySet()                    */
+#else
+#define OS_TASK_AFFINITY_EN       0u   /* 只读 Include code for OSTaskAffinitySet()                    */
+#endif
+#define OS_TASK_BUDGET_EN         1u   /*     Include code for OSTaskBudgetSet() (CPU budget throttling)*/
 #define OS_TASK_CHANGE_PRIO_EN    1u   /*     Include code for OSTaskChangePrio()                      */
-#define OS_TASK_CREATE_EN         0u   /*只读 Include code for OSTaskCreate()                          */
+#define OS_TASK_CREATE_EN         1u   /*     Include code for OSTaskCreate()                          */
 #define OS_TASK_CREATE_EXT_EN     1u   /*     Include code for OSTaskCreateExt()                       */
+#define OS_TASK_CREATE_TBL_EN     1u   /*     Include code for OSTaskCreateTable()                     */
 #define OS_TASK_DEL_EN            1u   /*     Include code for OSTaskDel()                             */
+#define OS_TASK_PERIODIC_EN       1u   /*     Include code for OSTaskPeriodSet() (periodic tasks)      */
+#define OS_TASK_GRP_EN            1u   /*     Include code for OSTaskGroupXxx()                        */
+#define OS_TASK_GRP_SIZE          8u   /*     Max. number of tasks in a task group                     */
+#ifdef RT_USING_SEMAPHORE              /* 是否开启由RT-Thread接管                                      */
+#define OS_TASK_LITE_EN           1u   /* 读写 Include code for OSTaskCreateLite()                     */
+#else
+#define OS_TASK_LITE_EN           0u   /* 只读 Include code for OSTaskCreateLite()                     */
+#endif
+#define OS_TASK_LITE_DISP_MAX     1u   /*     Max. number of priorities running lite tasks             */
 #define OS_TASK_NAME_EN           1u   /*     Enable task names                                        */
+#ifdef RT_USING_SEMAPHORE              /* 是否开启由RT-Thread接管                                      */
+#define OS_TASK_POOL_EN           1u   /* 读写 Include code for OSTaskPoolCreate() and OSTaskPoolRun() */
+#else
+#define OS_TASK_POOL_EN           0u   /* 只读 Include code for OSTaskPoolCreate() and OSTaskPoolRun() */
+#endif
 #define OS_TASK_PROFILE_EN        1u   /*     Include variables in OS_TCB for profiling                */
 #define OS_TASK_QUERY_EN          1u   /*     Include code for OSTaskQuery()                           */
 #define OS_TASK_REG_TBL_SIZE      1u   /*     Size of task variables array (#of INT32U entries)        */
@@ -81,18 +117,23 @@
 #define OS_TASK_STAT_STK_CHK_EN   1u   /*     Check task stacks from statistic task                    */
 #define OS_TASK_SUSPEND_EN        1u   /*     Include code for OSTaskSuspend() and OSTaskResume()      */
 #define OS_TASK_SW_HOOK_EN        1u   /*     Include code for OSTaskSwHook()                          */
+#define OS_TASK_TIME_SLICE_EN     1u   /*     Include code for OSTaskCreateExt2(), OSTaskTimeSliceSet()*/
+#define OS_TASK_TIME_SLICE_DFLT  10u   /*     Default round-robin time slice of a task (in ticks)      */
 
 
                                        /* ----------------------- EVENT FLAGS ------------------------ */
-#ifdef RT_USING_EVENT                  /* 是否开启由RT-Thread接管                                      */
-#define OS_FLAG_EN                1u   /* 读写 Enable (1) or Disable (0) code generation for EVENT FLAGS*/
-#else
-#define OS_FLAG_EN                0u   /* 只读 Enable (1) or Disable (0) code generation for EVENT FLAGS*/
-#endif
+#define OS_FLAG_EN                1u   /* Enable (1) or Disable (0) code generation for EVENT FLAGS    */
 #define OS_FLAG_ACCEPT_EN         1u   /*     Include code for OSFlagAccept()                          */
 #define OS_FLAG_DEL_EN            1u   /*     Include code for OSFlagDel()                             */
 #define OS_FLAG_QUERY_EN          1u   /*     Include code for OSFlagQuery()                           */
+#define OS_FLAG_PEND_MULTI_EN     1u   /*     Include code for OSFlagPendMulti()                       */
+#define OS_FLAG_MULTI_MAX         8u   /*     Max. number of groups OSFlagPendMulti() can wait on      */
+#define OS_FLAG_CB_EN             1u   /*     Include code for OSFlagCallbackRegister()                */
+#define OS_FLAG_CB_MAX            8u   /*     Max. number of event flag callbacks                      */
+#define OS_FLAG_CB_TASK_PRIO      4u   /*     Priority reserved for the deferred flag callback task    */
+#define OS_FLAG_CB_TASK_STK_SIZE 128u  /*     Deferred flag callback task stack size (# of OS_STK)     */
 #define OS_FLAG_WAIT_CLR_EN       1u   /* Include code for Wait on Clear EVENT FLAGS                   */
+#define OS_FLAGS_NBITS           32u   /* Size in #bits of OS_FLAGS data type (8, 16, 32 or 64)        */
 
                                        /* --------------------- MEMORY MANAGEMENT -------------------- */
 #define OS_MEM_EN                 1u   /* Enable (1) or Disable (0) code generation for MEMORY MANAGER */
@@ -153,7 +194,12 @@
                                        /* --------------------- TIME MANAGEMENT ---------------------- */
 #define OS_TIME_DLY_HMSM_EN       1u   /*     Include code for OSTimeDlyHMSM()                         */
 #define OS_TIME_DLY_RESUME_EN     1u   /*     Include code for OSTimeDlyResume()                       */
+#define OS_TIME_DLY_UNTIL_EN      1u   /*     Include code for OSTimeDlyUntil()                        */
 #define OS_TIME_GET_SET_EN        1u   /*     Include code for OSTimeGet() and OSTimeSet()             */
+#define OS_TIME_GET64_EN          1u   /*     Include code for OSTimeGet64() (64-bit tick counter)     */
+#define OS_TIME_MS_EN             1u   /*     Include OSTimeDlyMs(), OSTimeDlyUs() and OSxxxPendMs()   */
+#define OS_TIME_TS_EN             1u   /*     Include code for OSTimeTSToNs() and OSTimeTSToUs()       */
+#define OS_TIME_TICK_HOOK_EN      1u   /*     Include code for OSTimeTickHook()                        */
 
 
                                        /* --------------------- TIMER MANAGEMENT --------------------- */
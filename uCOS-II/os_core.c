@@ -37,11 +37,37 @@
 #define  OS_GLOBALS
 #include "ucos_ii.h"
 
+/*
+*********************************************************************************************************
+*                                           LOCAL VARIABLES
+*********************************************************************************************************
+*/
+
+#if (OS_CPU_HOOKS_EN > 0u) && (OS_TIME_TICK_HOOK_EN > 0u)
+static  struct rt_timer  OSTimeTickHookTmr;                /* Calls OSTimeTickHook() on every tick     */
+#endif
+
 /*
 *********************************************************************************************************
 *                                         FUNCTION PROTOTYPES
 *********************************************************************************************************
 */
+                                                 /* RT-Thread scheduler hook needed by profiling/hooks */
+#if defined(RT_USING_HOOK) && ((OS_TASK_PROFILE_EN > 0u) || ((OS_CPU_HOOKS_EN > 0u) && (OS_TASK_SW_HOOK_EN > 0u)))
+#define  OS_SCHED_HOOK_EN  1u
+#elif defined(RT_USING_HOOK) && (OS_TASK_CREATE_EXT_EN > 0u) && (OS_TLS_TBL_SIZE > 0u) && (OS_TLS_LIB_EN > 0u)
+#define  OS_SCHED_HOOK_EN  1u
+#else
+#define  OS_SCHED_HOOK_EN  0u
+#endif
+
+#if OS_SCHED_HOOK_EN > 0u
+static  void  OS_SchedHook (struct rt_thread *from, struct rt_thread *to);
+#endif
+
+#if (OS_CPU_HOOKS_EN > 0u) && (OS_TIME_TICK_HOOK_EN > 0u)
+static  void  OS_TimeTickHookTmr (void *parameter);
+#endif
 
 
 /*
@@ -59,8 +85,22 @@
 
 static  void  OS_InitMisc (void)
 {
+#if OS_PRIO_MAP_EN > 0u
+    INT16U  prio;
+
+
+    for (prio = 0u; prio <= OS_LOWEST_PRIO; prio++) {      /* Compress priorities onto RT-Thread's ... */
+        OSPrioMapTbl[prio] = (INT8U)(((INT32U)prio * RT_THREAD_PRIORITY_MAX) / OS_LOWEST_PRIO);
+    }                                                      /* ... keeping their relative order         */
+    OSPrioMapTbl[OS_LOWEST_PRIO] = RT_THREAD_PRIORITY_MAX - 1u;  /* Idle, lowest RT-Thread priority    */
+#endif
+
     OSTaskCtr                 = 0u;                        /* Clear the number of tasks                */
+#if OS_START_DEFER_EN > 0u
+    OSRunning                 = OS_FALSE;                  /* Tasks are held back until OSStart()      */
+#else
     OSRunning                 = OS_TRUE;                   /* 初始化时,rt-thread已经启动因此直接为OS_TRUE*/
+#endif
 
 #if OS_TASK_STAT_EN > 0u
     OSIdleCtrRun              = 0uL;
@@ -186,6 +226,9 @@ static  void  OS_InitTaskStat (void)
                           OS_TASK_OPT_STK_CHK | OS_TASK_OPT_STK_CLR);  /* Enable stack checking + clear  */
     #endif
 #else
+    #if OS_TASK_STK_REG_MAX > 0u
+    (void)OSTaskStkRegister(&OSTaskStatStk[0], OS_TASK_STAT_STK_SIZE); /* Let OSTaskCreate() know the size */
+    #endif
     #if OS_STK_GROWTH == 1u
     (void)OSTaskCreate(OS_TaskStat,
                        (void *)0,                                      /* No args passed to OS_TaskStat()*/
@@ -235,10 +278,48 @@ void  OSInit (void)
     OS_InitMisc();                                               /* Initialize miscellaneous variables       */
     OS_InitTCBList();                                            /* Initialize the free list of OS_TCBs      */
 
+    OS_CPU_TS_TmrInit();                                         /* Start the timestamp source               */
+#if OS_SCHED_HOOK_EN > 0u
+    rt_scheduler_sethook(OS_SchedHook);                          /* Hook context switches                    */
+#endif
+
+#if OS_TASK_CREATE_EXT_EN > 0u
+#if defined(OS_TLS_TBL_SIZE) && (OS_TLS_TBL_SIZE > 0u)
+    OS_TLS_Init(&err);                                           /* Initialize TLS, before creating tasks    */
+    if (err != OS_ERR_NONE) {
+        OSSchedUnlock();
+        return;
+    }
+#endif
+#endif
+
 #if (OS_MEM_EN > 0u) && (OS_MAX_MEM_PART > 0u)
     OS_MemInit();                                                /* Initialize the memory manager            */
 #endif
 
+#if (OS_FLAG_EN > 0u)
+    OS_FlagInit();                                               /* Initialize the event flag structures     */
+#endif
+
+#if OS_TASK_BUDGET_EN > 0u
+    OS_TaskBudgetInit();                                         /* Initialize the CPU budget timer          */
+#endif
+
+#if (OS_CPU_HOOKS_EN > 0u) && (OS_TIME_TICK_HOOK_EN > 0u)
+    rt_timer_init(&OSTimeTickHookTmr, "uCOS-II Tick",            /* Call OSTimeTickHook() on every tick      */
+                  OS_TimeTickHookTmr, RT_NULL, 1u,
+                  RT_TIMER_FLAG_PERIODIC | RT_TIMER_FLAG_HARD_TIMER);
+    rt_timer_start(&OSTimeTickHookTmr);
+#endif
+
+#if OS_TASK_LITE_EN > 0u
+    OS_LiteInit();                                               /* Initialize the lite task dispatchers     */
+#endif
+
+#if OS_TIME_GET64_EN > 0u
+    OS_Time64Init();                                             /* Initialize the 64-bit time base          */
+#endif
+
 #if OS_TASK_STAT_EN > 0u
     OS_InitTaskIdle();                                           /* Create the Idle Task                     */
     OS_InitTaskStat();                                           /* Create the Statistic Task                */
@@ -401,17 +482,43 @@ void  OSSchedUnlock (void)
 *
 * Returns    : none
 *
-* Note       : OSStartHighRdy() MUST:
-*                 a) Call OSTaskSwHook() then,
-*                 b) Set OSRunning to OS_TRUE.
-*                 c) Load the context of the task pointed to by OSTCBHighRdy.
-*                 d_ Execute the task.
+* Note(s)    : 1) RT-Thread is already running when OSInit() is called, so unless OS_START_DEFER_EN is
+*                 enabled, tasks run as soon as they are created and this function does nothing.
+*              2) With OS_START_DEFER_EN, the tasks created before OSStart() are not started by
+*                 OSTaskCreate()/OSTaskCreateExt().  OSStart() starts them all, from the highest priority
+*                 to the lowest, with the scheduler locked: the caller is only preempted once, by the
+*                 highest priority task, when the scheduler is unlocked.
+*              3) Unlike uC/OS-II on bare metal, OSStart() returns to its caller.
 *********************************************************************************************************
 */
 
 void  OSStart (void)
 {
-    /*do nothing*/
+#if OS_START_DEFER_EN > 0u
+    INT16U   prio;
+    OS_TCB  *ptcb;
+
+
+    if (OSRunning == OS_TRUE) {                  /* OSStart() must only be called once                 */
+        return;
+    }
+    rt_enter_critical();                         /* Release all the tasks in one batch                 */
+    OSRunning = OS_TRUE;
+    for (prio = 0u; prio <= OS_LOWEST_PRIO; prio++) {
+        ptcb = OSTCBPrioTbl[prio];
+        if ((ptcb == (OS_TCB *)0) || (ptcb == OS_TCB_RESERVED)) {
+            continue;
+        }
+        if ((ptcb->OSTask.stat & RT_THREAD_STAT_MASK) != RT_THREAD_INIT) {
+            continue;                            /* Not held back by OS_TaskCreate()                   */
+        }
+        rt_thread_startup(&ptcb->OSTask);
+        if ((ptcb->OSTCBStat & OS_STAT_SUSPEND) != OS_STAT_RDY) {
+            rt_thread_suspend(&ptcb->OSTask);    /* OSTaskSuspend() was called before OSStart()        */
+        }
+    }
+    rt_exit_critical();                          /* Run the highest priority task                      */
+#endif
 }
 
 
@@ -438,6 +545,9 @@ void  OSStart (void)
 #if OS_TASK_STAT_EN > 0u
 void  OSStatInit (void)
 {
+#ifdef RT_USING_SMP
+    INT8U      i;
+#endif
 #if OS_CRITICAL_METHOD == 3u                     /* Allocate storage for CPU status register           */
     OS_CPU_SR  cpu_sr = 0u;
 #endif
@@ -446,10 +556,20 @@ void  OSStatInit (void)
     OSTimeDly(2u);                               /* Synchronize with clock tick                        */
     OS_ENTER_CRITICAL();
     OSIdleCtr    = 0uL;                          /* Clear idle counter                                 */
+#ifdef RT_USING_SMP
+    for (i = 0u; i < RT_CPUS_NR; i++) {
+        OSIdleCtrCore[i] = 0uL;
+    }
+#endif
     OS_EXIT_CRITICAL();
     OSTimeDly(OS_TICKS_PER_SEC / 10u);           /* Determine MAX. idle counter value for 1/10 second  */
     OS_ENTER_CRITICAL();
     OSIdleCtrMax = OSIdleCtr;                    /* Store maximum idle counter count in 1/10 second    */
+#ifdef RT_USING_SMP
+    for (i = 0u; i < RT_CPUS_NR; i++) {
+        OSIdleCtrMaxCore[i] = OSIdleCtrCore[i];
+    }
+#endif
     OSStatRdy    = OS_TRUE;
     OS_EXIT_CRITICAL();
 }
@@ -467,6 +587,9 @@ void  OSStatInit (void)
 * Arguments  : none
 *
 * Returns    : none
+*
+* Note(s)    : 1) OSTimeTickHook() is called from a one-tick hard timer (see OS_TimeTickHookTmr()), it is
+*                 thus called whether the tick ISR calls this function or rt_tick_increase() directly.
 *********************************************************************************************************
 */
 
@@ -476,6 +599,31 @@ void  OSTimeTick (void)
 }
 
 
+/*
+*********************************************************************************************************
+*                                          TICK HOOK TIMER
+*
+* Description: This function is called by a periodic RT-Thread hard timer on every tick and calls
+*              OSTimeTickHook().
+*
+* Arguments  : parameter  is not used.
+*
+* Returns    : none
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*              2) The timer runs from rt_tick_increase(), i.e. from the tick ISR.
+*********************************************************************************************************
+*/
+
+#if (OS_CPU_HOOKS_EN > 0u) && (OS_TIME_TICK_HOOK_EN > 0u)
+static  void  OS_TimeTickHookTmr (void *parameter)
+{
+    (void)parameter;
+    OSTimeTickHook();                                      /* Call user definable hook                     */
+}
+#endif
+
+
 /*
 *********************************************************************************************************
 *                                             GET VERSION
@@ -605,6 +753,122 @@ void  OS_Sched (void)
 }
 
 
+/*
+*********************************************************************************************************
+*                                         CONTEXT SWITCH HOOK
+*
+* Description: This function is registered with rt_scheduler_sethook() and is called by RT-Thread on
+*              every context switch.  It accumulates the run time of the task being switched out,
+*              timestamps the task being switched in, installs its C library context (see os_tls.c)
+*              and calls OSTaskSwHook().
+*
+* Arguments  : from     is the RT-Thread thread being switched out
+*
+*              to       is the RT-Thread thread being switched in
+*
+* Returns    : none
+*
+* Notes      : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*              2) Interrupts are disabled during this call.
+*              3) Threads that were not created through uC/OS-II (e.g. the RT-Thread idle thread) are
+*                 not accounted and are passed to OSTaskSwHook() as a NULL pointer.
+*********************************************************************************************************
+*/
+
+#if OS_SCHED_HOOK_EN > 0u
+static  void  OS_SchedHook (struct rt_thread *from, struct rt_thread *to)
+{
+#if OS_TASK_PROFILE_EN > 0u
+    OS_TCB  *ptcb;
+    INT32U   ts;
+
+
+    ts   = OS_TS_GET();
+    ptcb = OS_TCBFromThread(from);
+    if (ptcb != (OS_TCB *)0) {
+        ptcb->OSTCBCyclesTot  += ts - ptcb->OSTCBCyclesStart;   /* Add the run time of this activation      */
+    }
+    ptcb = OS_TCBFromThread(to);
+    if (ptcb != (OS_TCB *)0) {
+        ptcb->OSTCBCyclesStart = ts;
+        ptcb->OSTCBCtxSwCtr++;                                  /* Count the number of times switched in    */
+    }
+#endif
+#if (OS_TASK_CREATE_EXT_EN > 0u) && (OS_TLS_TBL_SIZE > 0u) && (OS_TLS_LIB_EN > 0u)
+    OS_TLS_TaskSw();                                            /* Install the C library context of 'to'    */
+#endif
+#if (OS_CPU_HOOKS_EN > 0u) && (OS_TASK_SW_HOOK_EN > 0u)
+    OSTaskSwHook(OS_TCBFromThread(from),                        /* Call user definable hook                 */
+                 OS_TCBFromThread(to));
+#endif
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                       GET TCB OF AN RT-THREAD THREAD
+*
+* Description: This function returns the uC/OS-II TCB that embeds the given RT-Thread thread.
+*
+* Arguments  : thread   is the RT-Thread thread
+*
+* Returns    : a pointer to the TCB, or
+*              a NULL pointer if 'thread' was not created through uC/OS-II.
+*
+* Notes      : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*              2) All TCBs are taken from OSTCBTbl[], a simple range check is thus sufficient and this
+*                 function can safely be used from the scheduler hook.
+*********************************************************************************************************
+*/
+
+OS_TCB  *OS_TCBFromThread (struct rt_thread *thread)
+{
+    OS_TCB  *ptcb;
+
+
+    ptcb = (OS_TCB *)thread;
+    if ((ptcb <  &OSTCBTbl[0]) ||
+        (ptcb >= &OSTCBTbl[OS_MAX_TASKS + OS_N_SYS_TASKS])) {
+        return ((OS_TCB *)0);
+    }
+    return (ptcb);
+}
+
+
+/*
+*********************************************************************************************************
+*                                    GET PRIORITY OF THE CURRENT TASK
+*
+* Description: This function returns the priority of the running thread, it implements OSPrioCur when
+*              uC/OS-II priorities are mapped onto RT-Thread priorities.
+*
+* Arguments  : none
+*
+* Returns    : the uC/OS-II priority of the running task, or
+*              the RT-Thread priority if the running thread was not created through uC/OS-II.
+*
+* Notes      : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*********************************************************************************************************
+*/
+
+#if OS_PRIO_MAP_EN > 0u
+INT8U  OS_PrioCur (void)
+{
+    struct rt_thread  *thread;
+    OS_TCB            *ptcb;
+
+
+    thread = rt_thread_self();
+    ptcb   = OS_TCBFromThread(thread);
+    if (ptcb != (OS_TCB *)0) {
+        return (ptcb->OSTCBPrio);
+    }
+    return (thread->current_priority);                     /* Not a uC/OS-II task (e.g. RT-Thread idle) */
+}
+#endif
+
+
 #if OS_TASK_STAT_EN > 0u
 /*
 *********************************************************************************************************
@@ -636,11 +900,116 @@ void  OS_TaskIdle (void)
 
     OS_ENTER_CRITICAL();
     OSIdleCtr++;
+#ifdef RT_USING_SMP
+    OSIdleCtrCore[rt_hw_cpu_id()]++;             /* Each core runs its own idle thread                 */
+#endif
     OS_EXIT_CRITICAL();
 #if OS_CPU_HOOKS_EN > 0u
     OSTaskIdleHook();                            /* Call user definable HOOK                           */
 #endif
+#if OS_TICKLESS_EN > 0u
+    OS_TicklessIdle();                           /* Stop the tick until the next timer expires         */
+#endif
+}
+
+
+/*
+*********************************************************************************************************
+*                                          PER-CORE CPU USAGE
+*
+* Description: This function is called by OS_TaskStat() to compute the CPU usage of each core from its own
+*              idle counter, the same way OSCPUUsage is computed from OSIdleCtr.
+*
+* Arguments  : none
+*
+* Returns    : none
+*
+* Note(s)    : 1) OSIdleCtr counts the idle loops of all the cores, OSCPUUsage is thus the average usage.
+*              2) The per-core idle counters are cleared by OS_TaskStat() together with OSIdleCtr.
+*********************************************************************************************************
+*/
+
+#ifdef RT_USING_SMP
+static  void  OS_TaskStatCPUUsageCore (void)
+{
+    INT8U      i;
+    INT32U     run;
+    INT32U     idle;
+#if OS_CRITICAL_METHOD == 3u                     /* Allocate storage for CPU status register           */
+    OS_CPU_SR  cpu_sr = 0u;
+#endif
+
+
+    for (i = 0u; i < RT_CPUS_NR; i++) {
+        OS_ENTER_CRITICAL();
+        run = OSIdleCtrCore[i];
+        OS_EXIT_CRITICAL();
+        if (OSIdleCtrMaxCore[i] == 0uL) {        /* No calibration value for this core                 */
+            OSCPUUsageCore[i] = 0u;
+            continue;
+        }
+        idle = run / OSIdleCtrMaxCore[i];        /* Percentage of time spent idle                      */
+        if (idle <= 100uL) {
+            OSCPUUsageCore[i]   = (INT8U)(100uL - idle);
+        } else {
+            OSCPUUsageCore[i]   = 0u;
+            OSIdleCtrMaxCore[i] = run / 100uL;   /* Update max counter value to current one            */
+        }
+    }
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                          PER-TASK CPU USAGE
+*
+* Description: This function is called by OS_TaskStat() to compute the CPU usage of each task over the
+*              last sample period from the run time accumulated by OS_SchedHook():
+*
+*                                          OSTCBCyclesTot - OSTCBCyclesPrev
+*                 OSTCBCPUUsage = 100 * ----------------------------------     (units are in %)
+*                                             ts - ts_prev
+*
+* Arguments  : ts_prev  is the timestamp returned by the previous call.
+*
+* Returns    : the timestamp of this sample, to be passed to the next call.
+*********************************************************************************************************
+*/
+
+#if (OS_TASK_PROFILE_EN > 0u) && defined(RT_USING_HOOK)
+static  INT32U  OS_TaskStatCPUUsage (INT32U ts_prev)
+{
+    OS_TCB    *ptcb;
+    INT32U     ts;
+    INT32U     cycles;
+    INT32U     scale;
+    INT32U     usage;
+#if OS_CRITICAL_METHOD == 3u                     /* Allocate storage for CPU status register           */
+    OS_CPU_SR  cpu_sr = 0u;
+#endif
+
+
+    OS_ENTER_CRITICAL();
+    ts    = OS_TS_GET();
+    scale = (ts - ts_prev) / 100uL;              /* Timestamp counts per percent                       */
+    ptcb  = OSTCBList;
+    while (ptcb != (OS_TCB *)0) {
+        cycles = ptcb->OSTCBCyclesTot;
+        if (ptcb == OSTCBCur) {                  /* Include the current activation of this task        */
+            cycles += ts - ptcb->OSTCBCyclesStart;
+        }
+        if (scale > 0uL) {
+            usage = (cycles - ptcb->OSTCBCyclesPrev) / scale;
+            ptcb->OSTCBCPUUsage = (usage > 100uL) ? 100u : (INT8U)usage;
+        }
+        ptcb->OSTCBCyclesPrev = cycles;
+        ptcb = ptcb->OSTCBNext;
+    }
+    OS_EXIT_CRITICAL();
+    return (ts);
 }
+#endif
 
 
 /*
@@ -670,6 +1039,12 @@ void  OS_TaskIdle (void)
 void  OS_TaskStat (void *p_arg)
 {
     INT8S  usage;
+#ifdef RT_USING_SMP
+    INT8U  i;
+#endif
+#if (OS_TASK_PROFILE_EN > 0u) && defined(RT_USING_HOOK)
+    INT32U ts;
+#endif
 #if OS_CRITICAL_METHOD == 3u                     /* Allocate storage for CPU status register           */
     OS_CPU_SR  cpu_sr = 0u;
 #endif
@@ -681,6 +1056,11 @@ void  OS_TaskStat (void *p_arg)
         OSTimeDly(2u * OS_TICKS_PER_SEC / 10u);  /* Wait until statistic task is ready                 */
     }
     OSIdleCtrMax /= 100uL;
+#ifdef RT_USING_SMP
+    for (i = 0u; i < RT_CPUS_NR; i++) {
+        OSIdleCtrMaxCore[i] /= 100uL;
+    }
+#endif
     if (OSIdleCtrMax == 0uL) {
         OSCPUUsage = 0u;
 #if OS_TASK_SUSPEND_EN > 0u
@@ -694,11 +1074,19 @@ void  OS_TaskStat (void *p_arg)
     OS_ENTER_CRITICAL();
     OSIdleCtr = OSIdleCtrMax * 100uL;            /* Set initial CPU usage as 0%                        */
     OS_EXIT_CRITICAL();
+#if (OS_TASK_PROFILE_EN > 0u) && defined(RT_USING_HOOK)
+    ts = OS_TaskStatCPUUsage(OS_TS_GET());       /* Start the first per-task sample period             */
+#endif
     for (;;) {
         OSTimeDly(1);                            /* Synchronize with clock tick                        */
 
         OS_ENTER_CRITICAL();
         OSIdleCtr = 0uL;                        /* Reset the idle counter for the next second         */
+#ifdef RT_USING_SMP
+        for (i = 0u; i < RT_CPUS_NR; i++) {
+            OSIdleCtrCore[i] = 0uL;
+        }
+#endif
         OS_EXIT_CRITICAL();
 
         OSTimeDly(OS_TICKS_PER_SEC / 10u);       /* Accumulate OSIdleCtr for the next 1/10 second      */
@@ -714,6 +1102,12 @@ void  OS_TaskStat (void *p_arg)
             OSCPUUsage   = 0u;
             OSIdleCtrMax = OSIdleCtrRun / 100uL; /* Update max counter value to current one            */
         }
+#ifdef RT_USING_SMP
+        OS_TaskStatCPUUsageCore();               /* Compute the CPU usage of each core                 */
+#endif
+#if (OS_TASK_PROFILE_EN > 0u) && defined(RT_USING_HOOK)
+        ts = OS_TaskStatCPUUsage(ts);            /* Compute the CPU usage of each task                 */
+#endif
 
 #if OS_CPU_HOOKS_EN > 0u
         OSTaskStatHook();                        /* Invoke user definable hook                         */
@@ -735,6 +1129,10 @@ void  OS_TaskStat (void *p_arg)
 * Arguments  : none
 *
 * Returns    : none
+*
+* Note(s)    : 1) Only the tasks linked in OSTCBList are visited.  The walk restarts from the head of the
+*                 list if the task just checked was deleted meanwhile; this is cheap since checking a
+*                 stack whose watermark (cached in the TCB) didn't move only compares one entry.
 *********************************************************************************************************
 */
 
@@ -745,26 +1143,37 @@ void  OS_TaskStatStkChk (void)
     OS_STK_DATA  stk_data;
     INT8U        err;
     INT8U        prio;
+#if OS_CRITICAL_METHOD == 3u                                         /* Allocate storage for CPU status register */
+    OS_CPU_SR    cpu_sr = 0u;
+#endif
 
 
-    for (prio = 0u; prio <= OS_TASK_IDLE_PRIO; prio++) {
-        err = OSTaskStkChk(prio, &stk_data);
-        if (err == OS_ERR_NONE) {
-            ptcb = OSTCBPrioTbl[prio];
-            if (ptcb != (OS_TCB *)0) {                               /* Make sure task 'ptcb' is ...   */
-                if (ptcb != OS_TCB_RESERVED) {                       /* ... still valid.               */
+    OS_ENTER_CRITICAL();
+    ptcb = OSTCBList;
+    while (ptcb != (OS_TCB *)0) {
+        prio = ptcb->OSTCBPrio;
+        OS_EXIT_CRITICAL();
+        err  = OSTaskStkChk(prio, &stk_data);
+        OS_ENTER_CRITICAL();
+        if (OSTCBPrioTbl[prio] != ptcb) {                            /* Task deleted meanwhile, restart */
+            ptcb = OSTCBList;
+            continue;
+        }
 #if OS_TASK_PROFILE_EN > 0u
-                    #if OS_STK_GROWTH == 1u
-                    ptcb->OSTCBStkBase = ptcb->OSTCBStkBottom + ptcb->OSTCBStkSize;
-                    #else
-                    ptcb->OSTCBStkBase = ptcb->OSTCBStkBottom - ptcb->OSTCBStkSize;
-                    #endif
-                    ptcb->OSTCBStkUsed = stk_data.OSUsed;            /* Store number of entries used   */
-#endif
-                }
-            }
+        if (err == OS_ERR_NONE) {
+            #if OS_STK_GROWTH == 1u
+            ptcb->OSTCBStkBase = ptcb->OSTCBStkBottom + ptcb->OSTCBStkSize;
+            #else
+            ptcb->OSTCBStkBase = ptcb->OSTCBStkBottom - ptcb->OSTCBStkSize;
+            #endif
+            ptcb->OSTCBStkUsed = stk_data.OSUsed;                    /* Store number of entries used   */
         }
+#else
+        (void)err;
+#endif
+        ptcb = ptcb->OSTCBNext;
     }
+    OS_EXIT_CRITICAL();
 }
 #endif
 
@@ -855,6 +1264,7 @@ INT8U  OS_TCBInit (INT8U    prio,
         ptcb->OSTCBExtPtr        = pext;                   /* Store pointer to TCB extension           */
         ptcb->OSTCBStkSize       = stk_size;               /* Store stack size                         */
         ptcb->OSTCBStkBottom     = pbos;                   /* Store pointer to bottom of stack         */
+        ptcb->OSTCBStkFree       = OS_STK_FREE_UNKNOWN;    /* Stack watermark not scanned yet          */
         ptcb->OSTCBOpt           = opt;                    /* Store task options                       */
         ptcb->OSTCBId            = id;                     /* Store task ID                            */
 #else
@@ -875,11 +1285,40 @@ INT8U  OS_TCBInit (INT8U    prio,
 #endif
 #endif
 
+#if (OS_FLAG_EN > 0u)
+        ptcb->OSTCBFlagNode      = (OS_FLAG_NODE *)0;      /* Task is not pending on an event flag     */
+        ptcb->OSTCBFlagNodeCnt   = 0u;
+        ptcb->OSTCBFlagsRdy      = (OS_FLAGS)0;
+#endif
+
 #if OS_TASK_PROFILE_EN > 0u
+        ptcb->OSTCBCtxSwCtr      = 0uL;                    /* Clear the run time statistics            */
+        ptcb->OSTCBCyclesTot     = 0uL;
+        ptcb->OSTCBCyclesStart   = OS_TS_GET();
+        ptcb->OSTCBCyclesPrev    = 0uL;
+        ptcb->OSTCBCPUUsage      = 0u;
         ptcb->OSTCBStkBase       = (OS_STK *)0;
         ptcb->OSTCBStkUsed       = 0uL;
 #endif
 
+#if OS_TASK_BUDGET_EN > 0u
+        ptcb->OSTCBBudget          = 0uL;                  /* No CPU budget                            */
+        ptcb->OSTCBBudgetLeft      = 0uL;
+        ptcb->OSTCBBudgetPeriod    = 0uL;
+        ptcb->OSTCBBudgetPeriodLeft = 0uL;
+        ptcb->OSTCBBudgetOvrCtr    = 0uL;
+        ptcb->OSTCBBudgetThrottled = OS_FALSE;
+#endif
+
+#if OS_TASK_PERIODIC_EN > 0u
+        ptcb->OSTCBPeriod          = 0uL;                  /* Not periodic                             */
+        ptcb->OSTCBDeadline        = 0uL;
+        ptcb->OSTCBRelease         = 0uL;
+        ptcb->OSTCBReleaseCtr      = 0uL;
+        ptcb->OSTCBDeadlineMissCtr = 0uL;
+        ptcb->OSTCBRespTimeMax     = 0uL;
+#endif
+
 #if OS_TASK_NAME_EN > 0u
         ptcb->OSTCBTaskName      = (INT8U *)(void *)"?";
 #endif
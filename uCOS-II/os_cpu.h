@@ -69,6 +69,8 @@ typedef rt_uint16_t    INT16U;                   /* Unsigned 16 bit quantity
 typedef rt_int16_t     INT16S;                   /* Signed   16 bit quantity                           */
 typedef rt_uint32_t    INT32U;                   /* Unsigned 32 bit quantity                           */
 typedef rt_int32_t     INT32S;                   /* Signed   32 bit quantity                           */
+typedef rt_uint64_t    INT64U;                   /* Unsigned 64 bit quantity                           */
+typedef rt_int64_t     INT64S;                   /* Signed   64 bit quantity                           */
 typedef float          FP32;                     /* Single precision floating point                    */
 typedef double         FP64;                     /* Double precision floating point                    */
 
@@ -133,6 +135,12 @@ OS_CPU_SR  OS_CPU_SR_Save         (void);
 void       OS_CPU_SR_Restore      (OS_CPU_SR  cpu_sr);
 #endif
 
+void       OS_CPU_TS_TmrInit      (void);        /* Timestamp source, may be overridden (RT_WEAK)      */
+INT32U     OS_CPU_TS_TmrRd        (void);
+INT32U     OS_CPU_TS_TmrFreq      (void);
+
+INT32U     OS_CPU_TicklessSleep   (INT32U     ticks);   /* Tickless idle, provided by the BSP (RT_WEAK)  */
+
 /*
 *********************************************************************************************************
 *                                   EXTERNAL C LANGUAGE LINKAGE END
@@ -122,6 +122,32 @@ void  OSTaskDelHook (OS_TCB *ptcb)
 #endif
 
 
+/*
+*********************************************************************************************************
+*                                        TASK DEADLINE MISS HOOK
+*
+* Description: This function is called by OSTaskWaitNextPeriod() when a periodic task completed a cycle
+*              after its deadline.  This allows you to degrade gracefully, e.g. by stretching the period of
+*              the task with OSTaskPeriodSet().
+*
+* Arguments  : ptcb   is a pointer to the task control block of the late task.  OSTCBDeadlineMissCtr has
+*                     already been incremented.
+*
+* Note(s)    : 1) Interrupts are enabled during this call.
+*********************************************************************************************************
+*/
+#if (OS_CPU_HOOKS_EN > 0u) && (OS_TASK_PERIODIC_EN > 0u)
+void  OSTaskDeadlineMissHook (OS_TCB *ptcb)
+{
+#if OS_APP_HOOKS_EN > 0u
+    App_TaskDeadlineMissHook(ptcb);
+#else
+    (void)ptcb;                                                 /* Prevent compiler warning                             */
+#endif
+}
+#endif
+
+
 #if OS_TASK_STAT_EN > 0u
 /*
 *********************************************************************************************************
@@ -168,6 +194,37 @@ void  OSTaskStatHook (void)
 #endif
 
 
+/*
+*********************************************************************************************************
+*                                           TASK SWITCH HOOK
+*
+* Description: This function is called when a task switch is performed.  This allows you to perform other
+*              operations during a context switch.
+*
+* Arguments  : ptcb_cur        is a pointer to the TCB of the task being switched out.
+*
+*              ptcb_high_rdy   is a pointer to the TCB of the task being switched in.
+*
+* Note(s)    : 1) Interrupts are disabled during this call.
+*              2) The hook is called by RT-Thread's scheduler hook, after rt_thread_self() has already been
+*                 updated.  OSTCBCur thus refers to the task being switched IN, use the arguments instead.
+*              3) Either pointer is NULL when the thread was not created through uC/OS-II (e.g. the
+*                 RT-Thread idle thread).
+*********************************************************************************************************
+*/
+#if (OS_CPU_HOOKS_EN > 0u) && (OS_TASK_SW_HOOK_EN > 0u)
+void  OSTaskSwHook (OS_TCB *ptcb_cur, OS_TCB *ptcb_high_rdy)
+{
+#if OS_APP_HOOKS_EN > 0u
+    App_TaskSwHook(ptcb_cur, ptcb_high_rdy);
+#else
+    (void)ptcb_cur;                                             /* Prevent compiler warning                             */
+    (void)ptcb_high_rdy;
+#endif
+}
+#endif
+
+
 /*
 *********************************************************************************************************
 *                                           OS_TCBInit() HOOK
@@ -189,3 +246,161 @@ void  OSTCBInitHook (OS_TCB *ptcb)
 #endif
 }
 #endif
+
+
+/*
+*********************************************************************************************************
+*                                               TICK HOOK
+*
+* Description: This function is called every tick.
+*
+* Arguments  : none
+*
+* Note(s)    : 1) Interrupts may or may not be ENABLED during this call.
+*              2) The hook is called by a one-tick hard timer, i.e. from the tick ISR, whether the BSP calls
+*                 OSTimeTick() or rt_tick_increase().
+*********************************************************************************************************
+*/
+#if (OS_CPU_HOOKS_EN > 0u) && (OS_TIME_TICK_HOOK_EN > 0u)
+void  OSTimeTickHook (void)
+{
+#if OS_APP_HOOKS_EN > 0u
+    App_TimeTickHook();
+#endif
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                      TIMESTAMP TIMER INITIALIZATION
+*
+* Description: This function initializes the free running counter used by OS_CPU_TS_TmrRd().
+*
+* Arguments  : none
+*
+* Note(s)    : 1) On ARMv7-M/ARMv8-M Mainline (Cortex-M3/M4/M7/M33) the DWT cycle counter is used.  On a
+*                 host (simulator) build the monotonic clock is used instead and nothing has to be set
+*                 up.  Otherwise the counter falls back to the RT-Thread tick.
+*
+*              2) Both functions are declared RT_WEAK so that a BSP can plug in its own timestamp source
+*                 (e.g. a free running hardware timer) by simply defining them.
+*********************************************************************************************************
+*/
+
+#if defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__) || defined(__ARM_ARCH_8M_MAIN__) || \
+    defined(__TARGET_ARCH_7_M) || defined(__TARGET_ARCH_7E_M)
+#define  OS_CPU_TS_DWT
+#define  OS_CPU_REG_DEMCR               (*(volatile INT32U *)0xE000EDFCuL)  /* Debug Exception & Monitor Ctrl */
+#define  OS_CPU_REG_DWT_CTRL            (*(volatile INT32U *)0xE0001000uL)  /* DWT Control                    */
+#define  OS_CPU_REG_DWT_CYCCNT          (*(volatile INT32U *)0xE0001004uL)  /* DWT Cycle Count                */
+#define  OS_CPU_REG_DWT_LAR             (*(volatile INT32U *)0xE0001FB0uL)  /* DWT Lock Access (Cortex-M7)    */
+
+#define  OS_CPU_BIT_DEMCR_TRCENA        0x01000000uL
+#define  OS_CPU_BIT_DWT_CTRL_CYCCNTENA  0x00000001uL
+
+extern  INT32U  SystemCoreClock;                                /* CPU clock (in Hz), maintained by CMSIS               */
+#elif defined(__linux__) || defined(__unix__) || defined(__APPLE__)
+#define  OS_CPU_TS_HOST
+#include  <time.h>
+#endif
+
+RT_WEAK void  OS_CPU_TS_TmrInit (void)
+{
+#ifdef OS_CPU_TS_DWT
+    OS_CPU_REG_DEMCR      |= OS_CPU_BIT_DEMCR_TRCENA;           /* Enable access to the DWT unit                        */
+    OS_CPU_REG_DWT_LAR     = 0xC5ACCE55uL;                      /* Unlock the DWT (ignored on cores without a lock)     */
+    OS_CPU_REG_DWT_CYCCNT  = 0uL;
+    OS_CPU_REG_DWT_CTRL   |= OS_CPU_BIT_DWT_CTRL_CYCCNTENA;     /* Start the cycle counter                              */
+#endif
+}
+
+
+/*
+*********************************************************************************************************
+*                                         GET TIMESTAMP TIMER VALUE
+*
+* Description: This function returns the current value of the free running timestamp counter.  The counter
+*              is allowed to wrap around; callers only use the difference between two readings.
+*
+* Arguments  : none
+*
+* Returns    : CPU cycles (DWT), nanoseconds (host build) or ticks (fallback).
+*
+* Note(s)    : 1) This function is called by the scheduler hook with interrupts disabled, keep it short.
+*********************************************************************************************************
+*/
+
+RT_WEAK INT32U  OS_CPU_TS_TmrRd (void)
+{
+#if   defined(OS_CPU_TS_DWT)
+    return (OS_CPU_REG_DWT_CYCCNT);
+#elif defined(OS_CPU_TS_HOST)
+    struct timespec  ts;
+
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((INT32U)ts.tv_sec * 1000000000uL + (INT32U)ts.tv_nsec);
+#else
+    return ((INT32U)rt_tick_get());
+#endif
+}
+
+
+/*
+*********************************************************************************************************
+*                                       GET TIMESTAMP TIMER FREQUENCY
+*
+* Description: This function returns the frequency of the counter read by OS_CPU_TS_TmrRd().
+*
+* Arguments  : none
+*
+* Returns    : The number of timestamp counts per second: the CPU clock (DWT), 1000000000 (host build) or
+*              RT_TICK_PER_SECOND (fallback).
+*
+* Note(s)    : 1) A BSP that overrides OS_CPU_TS_TmrRd() MUST override this function as well.
+*              2) On Cortex-M the CPU clock is read from CMSIS' SystemCoreClock at each call, so that a
+*                 clock change (SystemCoreClockUpdate()) is taken into account.
+*********************************************************************************************************
+*/
+
+RT_WEAK INT32U  OS_CPU_TS_TmrFreq (void)
+{
+#if   defined(OS_CPU_TS_DWT)
+    return (SystemCoreClock);
+#elif defined(OS_CPU_TS_HOST)
+    return (1000000000uL);
+#else
+    return ((INT32U)RT_TICK_PER_SECOND);
+#endif
+}
+
+
+/*
+*********************************************************************************************************
+*                                          TICKLESS IDLE SLEEP
+*
+* Description: This function is called by OS_TicklessIdle() (OS_TICKLESS_EN) when no thread is ready.  It
+*              MUST stop the periodic tick, program a one-shot wake up 'ticks' ticks ahead, put the CPU to
+*              sleep, and, once woken up (by the one-shot timer or by any other interrupt), restart the
+*              periodic tick.
+*
+* Arguments  : ticks     is the number of ticks until the first RT-Thread timer expires.  Sleep less if the
+*                        hardware timer cannot reach that far.
+*
+* Returns    : The number of WHOLE ticks that elapsed while the tick was stopped.  The fraction of the
+*              current tick should be carried over, e.g. by restarting the periodic tick with the rest of
+*              the current tick period.
+*
+* Note(s)    : 1) Interrupts are disabled during this call.  The CPU must still be woken up by a pending
+*                 interrupt (WFI on Cortex-M does so while PRIMASK is set).
+*              2) This default version has no one-shot timer to program: it returns 0 and the tick keeps
+*                 running.  A BSP enables tickless idle by defining its own version.
+*********************************************************************************************************
+*/
+
+RT_WEAK INT32U  OS_CPU_TicklessSleep (INT32U  ticks)
+{
+    (void)ticks;
+    return (0u);
+}
@@ -38,6 +38,63 @@
 
 #if (OS_FLAG_EN > 0u)
 
+/*
+*********************************************************************************************************
+*                                           LOCAL VARIABLES
+*********************************************************************************************************
+*/
+
+#if OS_FLAG_CB_EN > 0u
+static  struct rt_thread  OSFlagCbTask;                    /* Deferred flag callback task              */
+static  BOOLEAN           OSFlagCbTaskCreated;             /* Task created by the first deferred cb.   */
+static  OS_FLAG_CB       *OSFlagCbPendHead;                /* Callbacks waiting for the callback task  */
+static  OS_FLAG_CB       *OSFlagCbPendTail;
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                          LOCAL PROTOTYPES
+*********************************************************************************************************
+*/
+
+static  INT8U    OS_FlagTest     (OS_FLAGS      flags_cur,
+                                  OS_FLAGS      flags,
+                                  INT8U         wait_type,
+                                  OS_FLAGS     *pflags_rdy);
+
+static  void     OS_FlagConsume  (OS_FLAG_GRP  *pgrp,
+                                  OS_FLAGS      flags_rdy,
+                                  INT8U         wait_type);
+
+static  void     OS_FlagLink     (OS_FLAG_GRP  *pgrp,
+                                  OS_FLAG_NODE *pnode,
+                                  OS_FLAGS      flags,
+                                  INT8U         wait_type,
+                                  BOOLEAN       consume);
+
+static  void     OS_FlagBlock    (OS_FLAG_NODE *pnodes,
+                                  INT8U         n,
+                                  INT32U        timeout);
+
+static  INT8U    OS_FlagPendEnd  (OS_FLAG_NODE *pnodes,
+                                  INT8U         n,
+                                  OS_FLAGS     *pflags_rdy,
+                                  INT8U        *pwhich);
+
+static  void     OS_FlagTaskRdy  (OS_FLAG_NODE *pnode,
+                                  OS_FLAGS      flags_rdy,
+                                  INT8U         pend_stat);
+
+#if OS_FLAG_CB_EN > 0u
+static  BOOLEAN  OS_FlagCbPost   (OS_FLAG_GRP  *pgrp);
+
+static  void     OS_FlagCbFree   (OS_FLAG_CB   *pcb);
+
+static  void     OS_FlagCbTask   (void         *p_arg);
+#endif
+
+
 /*
 *********************************************************************************************************
 *                          CHECK THE STATUS OF FLAGS IN AN EVENT FLAG GROUP
@@ -99,8 +156,9 @@ OS_FLAGS  OSFlagAccept (OS_FLAG_GRP  *pgrp,
     OS_FLAGS      flags_rdy;
     INT8U         result;
     BOOLEAN       consume;
-    rt_uint8_t    rt_option = 0;
-    rt_err_t      rt_err;
+#if OS_CRITICAL_METHOD == 3u                               /* Allocate storage for CPU status register */
+    OS_CPU_SR     cpu_sr = 0u;
+#endif
 
 
 #ifdef OS_SAFETY_CRITICAL
@@ -116,60 +174,207 @@ OS_FLAGS  OSFlagAccept (OS_FLAG_GRP  *pgrp,
         return ((OS_FLAGS)0);
     }
 #endif
-    if (rt_object_get_type(&pgrp->pFlagGrp->parent.parent) /* Validate event block type                */
-        != RT_Object_Class_Event) {
+    if (pgrp->OSFlagType != OS_EVENT_TYPE_FLAG) {          /* Validate event block type                */
         *perr = OS_ERR_EVENT_TYPE;
         return ((OS_FLAGS)0);
     }
     result = (INT8U)(wait_type & OS_FLAG_CONSUME);
     if (result != (INT8U)0) {                              /* See if we need to consume the flags      */
-        wait_type &= ~OS_FLAG_CONSUME;
+        wait_type &= (INT8U)~(INT8U)OS_FLAG_CONSUME;
         consume    = OS_TRUE;
     } else {
         consume    = OS_FALSE;
     }
 
-    *perr = OS_ERR_NONE;                                   /* Assume NO error until proven otherwise.  */
-    switch (wait_type) {
-        case OS_FLAG_WAIT_SET_ALL:                         /* See if all required flags are set        */
-            rt_option = RT_EVENT_FLAG_AND;
-            break;
+    OS_ENTER_CRITICAL();
+    *perr = OS_FlagTest(pgrp->OSFlagFlags, flags, wait_type, &flags_rdy);
+    if ((*perr == OS_ERR_NONE) && (consume == OS_TRUE)) {  /* See if we need to consume the flags      */
+        OS_FlagConsume(pgrp, flags_rdy, wait_type);
+    }
+    OS_EXIT_CRITICAL();
+    if (*perr != OS_ERR_NONE) {
+        flags_rdy = (OS_FLAGS)0;
+    }
+    return (flags_rdy);
+}
+#endif
 
-        case OS_FLAG_WAIT_SET_ANY:
-            rt_option = RT_EVENT_FLAG_OR;
-            break;
 
-#if OS_FLAG_WAIT_CLR_EN > 0u
-        case OS_FLAG_WAIT_CLR_ALL:                         /* See if all required flags are cleared    */
-            rt_option = RT_EVENT_FLAG_AND;
-            break;
+/*
+*********************************************************************************************************
+*                                 REGISTER A CALLBACK ON AN EVENT FLAG GROUP
+*
+* Description: This function registers a function that is called every time OSFlagPost() leaves the event
+*              flag group in a state that satisfies the condition described by 'flags' and 'wait_type'.
+*              This allows small reactions to run without a task (and a stack) of their own.
+*
+* Arguments  : pgrp          is a pointer to the desired event flag group.
+*
+*              flags         Is a bit pattern indicating which bit(s) (i.e. flags) you wish to watch.
+*
+*              wait_type     specifies the condition (see OSFlagPend()):
+*
+*                            OS_FLAG_WAIT_CLR_ALL   ALL bits in 'flags' are clear (0)
+*                            OS_FLAG_WAIT_CLR_ANY   ANY bit  in 'flags' is  clear (0)
+*                            OS_FLAG_WAIT_SET_ALL   ALL bits in 'flags' are set   (1)
+*                            OS_FLAG_WAIT_SET_ANY   ANY bit  in 'flags' is  set   (1)
+*
+*                            Add OS_FLAG_CONSUME to consume the flags when the condition is met and
+*                            OS_FLAG_CB_INLINE to call 'fnct' directly from OSFlagPost() instead of
+*                            from the deferred callback task.
+*
+*              fnct          is the function to call.  It receives the group, the flags that satisfied
+*                            the condition and 'p_arg'.
+*
+*              p_arg         is an argument passed to 'fnct'.
+*
+* Returns    : OS_ERR_NONE               The callback was registered.
+*              OS_ERR_FLAG_INVALID_PGRP  If 'pgrp' is a NULL pointer.
+*              OS_ERR_PDATA_NULL         If 'fnct' is a NULL pointer.
+*              OS_ERR_EVENT_TYPE         You are not pointing to an event flag group
+*              OS_ERR_FLAG_WAIT_TYPE     You didn't specify a proper 'wait_type' argument.
+*              OS_ERR_FLAG_CB_DEPLETED   No more callbacks available (see OS_FLAG_CB_MAX).
+*
+* Note(s)    : 1) Deferred callbacks run in a task at OS_FLAG_CB_TASK_PRIO.  When the condition is met
+*                 several times before the callback task runs, the callback is called once with all
+*                 the flags that were ready.  The task is created when the first deferred callback is
+*                 registered, its priority is reserved by OSInit() and can't be used by other tasks.
+*              2) Inline callbacks run inside OSFlagPost(), possibly from an ISR and with interrupts
+*                 disabled.  They must be short, must not block and must not post to their own group.
+*********************************************************************************************************
+*/
 
-        case OS_FLAG_WAIT_CLR_ANY:
-            rt_option = RT_EVENT_FLAG_OR;
-            break;
+#if OS_FLAG_CB_EN > 0u
+INT8U  OSFlagCallbackRegister (OS_FLAG_GRP      *pgrp,
+                               OS_FLAGS          flags,
+                               INT8U             wait_type,
+                               OS_FLAG_CALLBACK  fnct,
+                               void             *p_arg)
+{
+    OS_FLAG_CB   *pcb;
+    OS_FLAGS      flags_rdy;
+    BOOLEAN       start;
+#if OS_CRITICAL_METHOD == 3u                               /* Allocate storage for CPU status register */
+    OS_CPU_SR     cpu_sr = 0u;
 #endif
-        default:
-            *perr = OS_ERR_FLAG_WAIT_TYPE;
-            return 0;
-    }
 
-    if (consume == OS_TRUE){
-        rt_option |= RT_EVENT_FLAG_CLEAR;
-    }
 
-    rt_err = rt_event_recv(pgrp->pFlagGrp,
-                           flags,
-                           rt_option,
-                           RT_WAITING_NO,
-                           &flags_rdy);
-    if (rt_err == -RT_ETIMEOUT) {
-        *perr = OS_ERR_FLAG_NOT_RDY;
-        flags_rdy = 0;
-    } else {
-        *perr = OS_ERR_NONE;
+#if OS_ARG_CHK_EN > 0u
+    if (pgrp == (OS_FLAG_GRP *)0) {                        /* Validate 'pgrp'                          */
+        return (OS_ERR_FLAG_INVALID_PGRP);
+    }
+    if (fnct == (OS_FLAG_CALLBACK)0) {                     /* Validate 'fnct'                          */
+        return (OS_ERR_PDATA_NULL);
+    }
+#endif
+    if (pgrp->OSFlagType != OS_EVENT_TYPE_FLAG) {          /* Validate event block type                */
+        return (OS_ERR_EVENT_TYPE);
+    }
+    if (OS_FlagTest((OS_FLAGS)0,                           /* Validate 'wait_type'                     */
+                    (OS_FLAGS)0,
+                    (INT8U)(wait_type & (INT8U)~(INT8U)(OS_FLAG_CONSUME | OS_FLAG_CB_INLINE)),
+                    &flags_rdy) == OS_ERR_FLAG_WAIT_TYPE) {
+        return (OS_ERR_FLAG_WAIT_TYPE);
+    }
+    OS_ENTER_CRITICAL();
+    pcb = OSFlagCbFreeList;                                /* Get a free callback                      */
+    if (pcb == (OS_FLAG_CB *)0) {
+        OS_EXIT_CRITICAL();
+        return (OS_ERR_FLAG_CB_DEPLETED);
+    }
+    start = OS_FALSE;
+    if (((wait_type & OS_FLAG_CB_INLINE) == 0u) &&         /* First deferred callback: create the task */
+        (OSFlagCbTaskCreated == OS_FALSE)) {
+        rt_thread_init(&OSFlagCbTask,
+                       "uCFlagCb",
+                       OS_FlagCbTask,
+                       RT_NULL,
+                       &OSFlagCbTaskStk[0],
+                       sizeof(OSFlagCbTaskStk),
+                       OS_PRIO_TO_RT(OS_FLAG_CB_TASK_PRIO),
+                       0);
+        OSFlagCbTaskCreated = OS_TRUE;
+        start               = OS_TRUE;
     }
+    OSFlagCbFreeList       = pcb->OSFlagCbNext;
+    pcb->OSFlagCbGrp       = pgrp;
+    pcb->OSFlagCbFnct      = fnct;
+    pcb->OSFlagCbArg       = p_arg;
+    pcb->OSFlagCbFlags     = flags;
+    pcb->OSFlagCbFlagsRdy  = (OS_FLAGS)0;
+    pcb->OSFlagCbWaitType  = wait_type;
+    pcb->OSFlagCbPend      = OS_FALSE;
+    pcb->OSFlagCbPendNext  = (OS_FLAG_CB *)0;
+    pcb->OSFlagCbNext      = (OS_FLAG_CB *)pgrp->OSFlagCbList; /* Add to the group's callback list     */
+    pgrp->OSFlagCbList     = (void *)pcb;
+    OS_EXIT_CRITICAL();
+    if (start == OS_TRUE) {
+        rt_thread_startup(&OSFlagCbTask);                  /* Runs callbacks queued meanwhile, if any  */
+    }
+    return (OS_ERR_NONE);
+}
 
-    return (flags_rdy);
+
+/*
+*********************************************************************************************************
+*                               UNREGISTER A CALLBACK FROM AN EVENT FLAG GROUP
+*
+* Description: This function removes a callback registered with OSFlagCallbackRegister().
+*
+* Arguments  : pgrp          is a pointer to the desired event flag group.
+*
+*              fnct          is the function that was registered.
+*
+*              p_arg         is the argument that was registered with 'fnct'.
+*
+* Returns    : OS_ERR_NONE               The callback was removed.
+*              OS_ERR_FLAG_INVALID_PGRP  If 'pgrp' is a NULL pointer.
+*              OS_ERR_EVENT_TYPE         You are not pointing to an event flag group
+*              OS_ERR_FLAG_CB_NOT_FOUND  No such callback is registered on 'pgrp'.
+*
+* Note(s)    : 1) A deferred call that has not run yet is cancelled.
+*********************************************************************************************************
+*/
+
+INT8U  OSFlagCallbackUnregister (OS_FLAG_GRP      *pgrp,
+                                 OS_FLAG_CALLBACK  fnct,
+                                 void             *p_arg)
+{
+    OS_FLAG_CB   *pcb;
+    OS_FLAG_CB   *pcb_prev;
+#if OS_CRITICAL_METHOD == 3u                               /* Allocate storage for CPU status register */
+    OS_CPU_SR     cpu_sr = 0u;
+#endif
+
+
+#if OS_ARG_CHK_EN > 0u
+    if (pgrp == (OS_FLAG_GRP *)0) {                        /* Validate 'pgrp'                          */
+        return (OS_ERR_FLAG_INVALID_PGRP);
+    }
+#endif
+    if (pgrp->OSFlagType != OS_EVENT_TYPE_FLAG) {          /* Validate event block type                */
+        return (OS_ERR_EVENT_TYPE);
+    }
+    OS_ENTER_CRITICAL();
+    pcb_prev = (OS_FLAG_CB *)0;
+    pcb      = (OS_FLAG_CB *)pgrp->OSFlagCbList;
+    while (pcb != (OS_FLAG_CB *)0) {
+        if ((pcb->OSFlagCbFnct == fnct) &&
+            (pcb->OSFlagCbArg  == p_arg)) {
+            if (pcb_prev == (OS_FLAG_CB *)0) {             /* Unlink from the group's callback list    */
+                pgrp->OSFlagCbList     = (void *)pcb->OSFlagCbNext;
+            } else {
+                pcb_prev->OSFlagCbNext = pcb->OSFlagCbNext;
+            }
+            OS_FlagCbFree(pcb);
+            OS_EXIT_CRITICAL();
+            return (OS_ERR_NONE);
+        }
+        pcb_prev = pcb;
+        pcb      = pcb->OSFlagCbNext;
+    }
+    OS_EXIT_CRITICAL();
+    return (OS_ERR_FLAG_CB_NOT_FOUND);
 }
 #endif
 
@@ -203,7 +408,7 @@ OS_FLAG_GRP  *OSFlagCreate (OS_FLAGS  flags,
 #if OS_CRITICAL_METHOD == 3u                        /* Allocate storage for CPU status register        */
     OS_CPU_SR    cpu_sr = 0u;
 #endif
-    rt_event_t rt_event;
+
 
 #ifdef OS_SAFETY_CRITICAL
     if (perr == (INT8U *)0) {
@@ -225,24 +430,24 @@ OS_FLAG_GRP  *OSFlagCreate (OS_FLAGS  flags,
         return ((OS_FLAG_GRP *)0);
     }
 
-    pgrp = RT_KERNEL_MALLOC(sizeof(OS_FLAG_GRP));
-    if (pgrp == (OS_FLAG_GRP *)0) {                 /* Get an event control block               */
-        return ((OS_FLAG_GRP *)0);
-    }
-
-    rt_event = rt_event_create("uCOS-II", RT_IPC_FLAG_PRIO);
-    if(!rt_event) {
+    pgrp = RT_KERNEL_MALLOC(sizeof(OS_FLAG_GRP));   /* Get an event flag group                         */
+    if (pgrp == (OS_FLAG_GRP *)0) {
         *perr = OS_ERR_FLAG_GRP_DEPLETED;
-        RT_KERNEL_FREE(pgrp);
-    } else {
-        *perr = OS_ERR_NONE;
+        return ((OS_FLAG_GRP *)0);
     }
 
     OS_ENTER_CRITICAL();
-    pgrp->pFlagGrp    = rt_event;
-    pgrp->OSFlagFlags = flags;
+    pgrp->OSFlagType     = OS_EVENT_TYPE_FLAG;      /* Set to event flag group type                    */
+    pgrp->OSFlagFlags    = flags;                   /* Set to desired initial value                    */
+    pgrp->OSFlagWaitList = (void *)0;               /* Clear list of tasks waiting on flags            */
+#if OS_FLAG_NAME_EN > 0u
+    pgrp->OSFlagName     = (INT8U *)(void *)"?";
+#endif
+#if OS_FLAG_CB_EN > 0u
+    pgrp->OSFlagCbList   = (void *)0;               /* No callback registered yet                      */
+#endif
     OS_EXIT_CRITICAL();
-
+    *perr                = OS_ERR_NONE;
     return (pgrp);                                  /* Return pointer to event flag group              */
 }
 
@@ -292,7 +497,12 @@ OS_FLAG_GRP  *OSFlagDel (OS_FLAG_GRP  *pgrp,
                          INT8U         opt,
                          INT8U        *perr)
 {
+    BOOLEAN       tasks_waiting;
+    OS_FLAG_NODE *pnode;
     OS_FLAG_GRP  *pgrp_return;
+#if OS_FLAG_CB_EN > 0u
+    OS_FLAG_CB   *pcb;
+#endif
 #if OS_CRITICAL_METHOD == 3u                               /* Allocate storage for CPU status register */
     OS_CPU_SR     cpu_sr = 0u;
 #endif
@@ -324,18 +534,30 @@ OS_FLAG_GRP  *OSFlagDel (OS_FLAG_GRP  *pgrp,
         *perr = OS_ERR_DEL_ISR;                            /* ... can't DELETE from an ISR             */
         return (pgrp);
     }
-    if (rt_object_get_type(&pgrp->pFlagGrp->parent.parent) /* Validate event block type                */
-        != RT_Object_Class_Event) {
+    if (pgrp->OSFlagType != OS_EVENT_TYPE_FLAG) {          /* Validate event group type                */
         *perr = OS_ERR_EVENT_TYPE;
         return (pgrp);
     }
     OS_ENTER_CRITICAL();
+    if (pgrp->OSFlagWaitList != (void *)0) {               /* See if any tasks waiting on event flags  */
+        tasks_waiting = OS_TRUE;                           /* Yes                                      */
+    } else {
+        tasks_waiting = OS_FALSE;                          /* No                                       */
+    }
     switch (opt) {
         case OS_DEL_NO_PEND:                               /* Delete group if no task waiting          */
-             if (rt_list_isempty(&(pgrp->pFlagGrp->parent.suspend_thread))) { /* 若没有线程等待信号量  */
+             if (tasks_waiting == OS_FALSE) {
+#if OS_FLAG_CB_EN > 0u
+                 pcb = (OS_FLAG_CB *)pgrp->OSFlagCbList;
+                 while (pcb != (OS_FLAG_CB *)0) {          /* Release callbacks of the group           */
+                     pgrp->OSFlagCbList = (void *)pcb->OSFlagCbNext;
+                     OS_FlagCbFree(pcb);
+                     pcb = (OS_FLAG_CB *)pgrp->OSFlagCbList;
+                 }
+#endif
+                 pgrp->OSFlagType     = OS_EVENT_TYPE_UNUSED;
                  pgrp->OSFlagFlags    = (OS_FLAGS)0;
                  OS_EXIT_CRITICAL();
-                 rt_event_detach(pgrp->pFlagGrp);
                  RT_KERNEL_FREE(pgrp);
                  *perr                = OS_ERR_NONE;
                  pgrp_return          = (OS_FLAG_GRP *)0;  /* Event Flag Group has been deleted        */
@@ -347,11 +569,27 @@ OS_FLAG_GRP  *OSFlagDel (OS_FLAG_GRP  *pgrp,
              break;
 
         case OS_DEL_ALWAYS:                                /* Always delete the event flag group       */
+             pnode = (OS_FLAG_NODE *)pgrp->OSFlagWaitList;
+             while (pnode != (OS_FLAG_NODE *)0) {          /* Ready ALL tasks waiting for flags        */
+                 OS_FlagTaskRdy(pnode, (OS_FLAGS)0, OS_STAT_PEND_ABORT);
+                 pnode = (OS_FLAG_NODE *)pgrp->OSFlagWaitList;
+             }
+#if OS_FLAG_CB_EN > 0u
+             pcb = (OS_FLAG_CB *)pgrp->OSFlagCbList;
+             while (pcb != (OS_FLAG_CB *)0) {              /* Release callbacks of the group           */
+                 pgrp->OSFlagCbList = (void *)pcb->OSFlagCbNext;
+                 OS_FlagCbFree(pcb);
+                 pcb = (OS_FLAG_CB *)pgrp->OSFlagCbList;
+             }
+#endif
+             pgrp->OSFlagType     = OS_EVENT_TYPE_UNUSED;
              pgrp->OSFlagFlags    = (OS_FLAGS)0;
              OS_EXIT_CRITICAL();
-             rt_event_detach(pgrp->pFlagGrp);
              RT_KERNEL_FREE(pgrp);
-             *perr = OS_ERR_NONE;
+             if (tasks_waiting == OS_TRUE) {               /* Reschedule only if task(s) were waiting  */
+                 OS_Sched();                               /* Find highest priority task ready to run  */
+             }
+             *perr                = OS_ERR_NONE;
              pgrp_return          = (OS_FLAG_GRP *)0;      /* Event Flag Group has been deleted        */
              break;
 
@@ -367,7 +605,6 @@ OS_FLAG_GRP  *OSFlagDel (OS_FLAG_GRP  *pgrp,
 #endif
 
 
-
 /*
 *********************************************************************************************************
 *                                ASSIGN A NAME TO AN EVENT FLAG GROUP
@@ -431,7 +668,6 @@ void  OSFlagNameSet (OS_FLAG_GRP  *pgrp,
     }
     pgrp->OSFlagName = pname;
     OS_EXIT_CRITICAL();
-    OS_TRACE_EVENT_NAME_SET(pgrp, pname);
     *perr            = OS_ERR_NONE;
     return;
 }
@@ -489,6 +725,8 @@ void  OSFlagNameSet (OS_FLAG_GRP  *pgrp,
 * Note(s)    : 1) IMPORTANT, the behavior of this function has changed from PREVIOUS versions.  The
 *                 function NOW returns the flags that were ready INSTEAD of the current state of the
 *                 event flags.
+*              2) When OS_FLAG_CONSUME is specified, the flags are consumed by OSFlagPost() at the moment
+*                 the task is readied so that two tasks can never consume the same flags.
 *********************************************************************************************************
 */
 
@@ -498,14 +736,14 @@ OS_FLAGS  OSFlagPend (OS_FLAG_GRP  *pgrp,
                       INT32U        timeout,
                       INT8U        *perr)
 {
+    OS_FLAG_NODE  node;                                    /* Wait list node, lives on the task stack  */
+    OS_FLAGS      flags_rdy;
+    INT8U         result;
+    INT8U         which;
+    BOOLEAN       consume;
 #if OS_CRITICAL_METHOD == 3u                               /* Allocate storage for CPU status register */
     OS_CPU_SR     cpu_sr = 0u;
 #endif
-    rt_err_t      rt_err;
-    INT8U         result;
-    BOOLEAN       consume;
-    rt_uint8_t    rt_option = 0;
-    OS_FLAGS      flags_rdy;
 
 
 #ifdef OS_SAFETY_CRITICAL
@@ -530,8 +768,7 @@ OS_FLAGS  OSFlagPend (OS_FLAG_GRP  *pgrp,
         *perr = OS_ERR_PEND_LOCKED;                        /* ... can't PEND when locked               */
         return ((OS_FLAGS)0);
     }
-    if (rt_object_get_type(&pgrp->pFlagGrp->parent.parent) /* Validate event block type                */
-        != RT_Object_Class_Event) {
+    if (pgrp->OSFlagType != OS_EVENT_TYPE_FLAG) {          /* Validate event block type                */
         *perr = OS_ERR_EVENT_TYPE;
         return ((OS_FLAGS)0);
     }
@@ -544,72 +781,176 @@ OS_FLAGS  OSFlagPend (OS_FLAG_GRP  *pgrp,
         consume    = OS_FALSE;
     }
 
-    *perr = OS_ERR_NONE;                                   /* Assume NO error until proven otherwise.  */
-    switch (wait_type) {
-        case OS_FLAG_WAIT_SET_ALL:                         /* See if all required flags are set        */
-            rt_option = RT_EVENT_FLAG_AND;
-            break;
+    OS_ENTER_CRITICAL();
+    result = OS_FlagTest(pgrp->OSFlagFlags, flags, wait_type, &flags_rdy);
+    if (result == OS_ERR_NONE) {                           /* Condition already satisfied              */
+        if (consume == OS_TRUE) {                          /* See if we need to consume the flags      */
+            OS_FlagConsume(pgrp, flags_rdy, wait_type);
+        }
+        OSTCBCur->OSTCBFlagsRdy = flags_rdy;               /* Save flags that were ready               */
+        OS_EXIT_CRITICAL();
+        *perr                   = OS_ERR_NONE;
+        return (flags_rdy);
+    }
+    if (result != OS_ERR_FLAG_NOT_RDY) {                   /* Invalid 'wait_type'                      */
+        OS_EXIT_CRITICAL();
+        *perr                   = result;
+        return ((OS_FLAGS)0);
+    }
+    OS_FlagLink(pgrp, &node, flags, wait_type, consume);   /* Add node to the group's wait list        */
+    OS_FlagBlock(&node, 1u, timeout);                      /* Suspend task until event or TO           */
+    OS_EXIT_CRITICAL();
+    OS_Sched();                                            /* Find next HPT ready to run               */
 
-        case OS_FLAG_WAIT_SET_ANY:
-            rt_option = RT_EVENT_FLAG_OR;
-            break;
+    *perr = OS_FlagPendEnd(&node, 1u, &flags_rdy, &which);
+    return (flags_rdy);
+}
 
-#if OS_FLAG_WAIT_CLR_EN > 0u
-        case OS_FLAG_WAIT_CLR_ALL:                         /* See if all required flags are cleared    */
-            rt_option = RT_EVENT_FLAG_AND;
-            break;
 
-        case OS_FLAG_WAIT_CLR_ANY:
-            rt_option = RT_EVENT_FLAG_OR;
-            break;
+/*
+*********************************************************************************************************
+*                                WAIT ON MULTIPLE EVENT FLAG GROUPS
+*
+* Description: This function is called to wait on several event flag groups at once.  The task is
+*              suspended only once and is readied as soon as the condition of ANY of the groups is met.
+*
+* Arguments  : pgrps         is an array of pointers to the event flag groups to wait on.
+*
+*              pflags        is an array holding, for each group, the bit pattern to wait for.
+*
+*              pwait_types   is an array holding, for each group, the type of wait (see OSFlagPend()).
+*                            OS_FLAG_CONSUME may be added to any entry.
+*
+*              n             is the number of entries in the arrays (1..OS_FLAG_MULTI_MAX).
+*
+*              timeout       is an optional timeout (in clock ticks) that your task will wait.  If you
+*                            specify 0, however, your task will wait forever.
+*
+*              pwhich        is a pointer to where the index of the group that made the task ready will
+*                            be stored.  'n' is stored if no group made the task ready.
+*
+*              perr          is a pointer to an error code and can be:
+*                            OS_ERR_NONE               One of the conditions was met within 'timeout'.
+*                            OS_ERR_PEND_ISR           If you tried to PEND from an ISR
+*                            OS_ERR_PEND_LOCKED        If you called this function with the scheduler locked
+*                            OS_ERR_PDATA_NULL         If one of the arrays or 'pwhich' is a NULL pointer.
+*                            OS_ERR_INVALID_OPT        If 'n' is 0 or larger than OS_FLAG_MULTI_MAX.
+*                            OS_ERR_FLAG_INVALID_PGRP  If one of the group pointers is a NULL pointer.
+*                            OS_ERR_EVENT_TYPE         If one of the pointers is not an event flag group.
+*                            OS_ERR_FLAG_WAIT_TYPE     If one of the 'wait_type' entries is invalid.
+*                            OS_ERR_TIMEOUT            None of the conditions was met within 'timeout'.
+*                            OS_ERR_PEND_ABORT         The wait was aborted (i.e. a group was deleted).
+*
+* Returns    : The flags of the group that made the task ready or, 0 if a timeout or an error occurred.
+*
+* Called from: Task ONLY
+*
+* Note(s)    : 1) The groups are checked in array order, so when several conditions are already met the
+*                 lowest index wins.
+*              2) One wait list node per group is kept on the caller's stack (OS_FLAG_MULTI_MAX nodes).
+*********************************************************************************************************
+*/
+
+#if OS_FLAG_PEND_MULTI_EN > 0u
+OS_FLAGS  OSFlagPendMulti (OS_FLAG_GRP  **pgrps,
+                           OS_FLAGS      *pflags,
+                           INT8U         *pwait_types,
+                           INT8U          n,
+                           INT32U         timeout,
+                           INT8U         *pwhich,
+                           INT8U         *perr)
+{
+    OS_FLAG_NODE  nodes[OS_FLAG_MULTI_MAX];                /* Wait list nodes, live on the task stack  */
+    OS_FLAG_GRP  *pgrp;
+    OS_FLAGS      flags_rdy;
+    INT8U         wait_type;
+    INT8U         result;
+    INT8U         i;
+#if OS_CRITICAL_METHOD == 3u                               /* Allocate storage for CPU status register */
+    OS_CPU_SR     cpu_sr = 0u;
 #endif
-        default:
-            *perr = OS_ERR_FLAG_WAIT_TYPE;
-            return 0;
-    }
 
-    if (consume == OS_TRUE){
-        rt_option |= RT_EVENT_FLAG_CLEAR;
+
+#ifdef OS_SAFETY_CRITICAL
+    if (perr == (INT8U *)0) {
+        OS_SAFETY_CRITICAL_EXCEPTION();
+        return ((OS_FLAGS)0);
     }
+#endif
 
-    OS_ENTER_CRITICAL();                              /* Otherwise, must wait until event occurs       */
-    OSTCBCur->OSTCBStat     |= OS_STAT_FLAG;          /* Resource not available, pend on semaphore     */
-    OSTCBCur->OSTCBStatPend  = OS_STAT_PEND_OK;
-#ifndef PKG_USING_UCOSII_WRAPPER_TINY
-    OSTCBCur->OSTCBDly       = timeout;               /* Store pend timeout in TCB                     */
-    OSTCBCur->OSTCBFlagsRdy  = rt_thread_self()->event_set;
+#if OS_ARG_CHK_EN > 0u
+    if ((pgrps       == (OS_FLAG_GRP **)0) ||              /* Validate the arrays                      */
+        (pflags      == (OS_FLAGS     *)0) ||
+        (pwait_types == (INT8U        *)0) ||
+        (pwhich      == (INT8U        *)0)) {
+        *perr = OS_ERR_PDATA_NULL;
+        return ((OS_FLAGS)0);
+    }
+    if ((n == 0u) || (n > OS_FLAG_MULTI_MAX)) {            /* Validate number of groups                */
+        *pwhich = n;
+        *perr   = OS_ERR_INVALID_OPT;
+        return ((OS_FLAGS)0);
+    }
 #endif
-    OS_EXIT_CRITICAL();
+    *pwhich = n;                                           /* Assume no group will make us ready       */
 
-    if(timeout) {                                     /* 0为永久等待                                   */
-        rt_err = rt_event_recv(pgrp->pFlagGrp,
-                               flags,
-                               rt_option,
-                               timeout,
-                               &flags_rdy);
-        if (rt_err == -RT_ETIMEOUT) {
-            *perr = OS_ERR_TIMEOUT;
-        } else {
-            *perr = OS_ERR_NONE;
+    if (OSIntNesting > 0u) {                               /* See if called from ISR ...               */
+        *perr = OS_ERR_PEND_ISR;                           /* ... can't PEND from an ISR               */
+        return ((OS_FLAGS)0);
+    }
+    if (OSLockNesting > 0u) {                              /* See if called with scheduler locked ...  */
+        *perr = OS_ERR_PEND_LOCKED;                        /* ... can't PEND when locked               */
+        return ((OS_FLAGS)0);
+    }
+    for (i = 0u; i < n; i++) {                             /* Validate every group and wait type       */
+        pgrp = pgrps[i];
+        if (pgrp == (OS_FLAG_GRP *)0) {
+            *perr = OS_ERR_FLAG_INVALID_PGRP;
+            return ((OS_FLAGS)0);
+        }
+        if (pgrp->OSFlagType != OS_EVENT_TYPE_FLAG) {
+            *perr = OS_ERR_EVENT_TYPE;
+            return ((OS_FLAGS)0);
+        }
+        wait_type = (INT8U)(pwait_types[i] & (INT8U)~(INT8U)OS_FLAG_CONSUME);
+        if (OS_FlagTest((OS_FLAGS)0, (OS_FLAGS)0, wait_type, &flags_rdy) == OS_ERR_FLAG_WAIT_TYPE) {
+            *perr = OS_ERR_FLAG_WAIT_TYPE;
+            return ((OS_FLAGS)0);
         }
-    } else {
-        rt_err = rt_event_recv(pgrp->pFlagGrp,
-                               flags,
-                               rt_option,
-                               RT_WAITING_FOREVER,
-                               &flags_rdy);
-        *perr = OS_ERR_NONE;
     }
 
     OS_ENTER_CRITICAL();
-#ifndef PKG_USING_UCOSII_WRAPPER_TINY
-    OSTCBCur->OSTCBFlagsRdy      = rt_thread_self()->event_set;
-#endif
-    OSTCBCur->OSTCBStat          =  OS_STAT_RDY;      /* Set   task  status to ready                   */
+    for (i = 0u; i < n; i++) {                             /* See if any condition is already met      */
+        wait_type = (INT8U)(pwait_types[i] & (INT8U)~(INT8U)OS_FLAG_CONSUME);
+        result    = OS_FlagTest(pgrps[i]->OSFlagFlags, pflags[i], wait_type, &flags_rdy);
+        if (result == OS_ERR_NONE) {
+            if ((pwait_types[i] & OS_FLAG_CONSUME) != 0u) {/* See if we need to consume the flags      */
+                OS_FlagConsume(pgrps[i], flags_rdy, wait_type);
+            }
+            OSTCBCur->OSTCBFlagsRdy = flags_rdy;           /* Save flags that were ready               */
+            OS_EXIT_CRITICAL();
+            *pwhich                 = i;
+            *perr                   = OS_ERR_NONE;
+            return (flags_rdy);
+        }
+    }
+    for (i = 0u; i < n; i++) {                             /* Add a node to every group's wait list    */
+        wait_type = (INT8U)(pwait_types[i] & (INT8U)~(INT8U)OS_FLAG_CONSUME);
+        OS_FlagLink(pgrps[i],
+                    &nodes[i],
+                    pflags[i],
+                    wait_type,
+                    ((pwait_types[i] & OS_FLAG_CONSUME) != 0u) ? OS_TRUE : OS_FALSE);
+    }
+    OS_FlagBlock(&nodes[0], n, timeout);                   /* Suspend task until event or TO           */
+    OSTCBCur->OSTCBStat |= OS_STAT_MULTI;                  /* Pending on multiple event flag groups    */
     OS_EXIT_CRITICAL();
+    OS_Sched();                                            /* Find next HPT ready to run               */
 
+    *perr = OS_FlagPendEnd(&nodes[0], n, &flags_rdy, pwhich);
     return (flags_rdy);
 }
+#endif
 
 
 /*
@@ -634,11 +975,9 @@ OS_FLAGS  OSFlagPendGetFlagsRdy (void)
     OS_CPU_SR     cpu_sr = 0u;
 #endif
 
+
     OS_ENTER_CRITICAL();
-    flags = rt_thread_self()->event_set;
-#ifndef PKG_USING_UCOSII_WRAPPER_TINY
-    OSTCBCur->OSTCBFlagsRdy = flags;
-#endif
+    flags = OSTCBCur->OSTCBFlagsRdy;
     OS_EXIT_CRITICAL();
     return (flags);
 }
@@ -682,7 +1021,7 @@ OS_FLAGS  OSFlagPendGetFlagsRdy (void)
 * WARNING(s) : 1) The execution time of this function depends on the number of tasks waiting on the event
 *                 flag group.
 *              2) The amount of time interrupts are DISABLED depends on the number of tasks waiting on
-*                 the event flag group.
+*                 the event flag group (and on the callbacks registered with OS_FLAG_CB_INLINE).
 *********************************************************************************************************
 */
 OS_FLAGS  OSFlagPost (OS_FLAG_GRP  *pgrp,
@@ -690,7 +1029,11 @@ OS_FLAGS  OSFlagPost (OS_FLAG_GRP  *pgrp,
                       INT8U         opt,
                       INT8U        *perr)
 {
-    rt_err_t      rt_err;
+    OS_FLAG_NODE *pnode;
+    OS_FLAG_NODE *pnode_next;
+    OS_FLAGS      flags_cur;
+    OS_FLAGS      flags_rdy;
+    BOOLEAN       sched;
 #if OS_CRITICAL_METHOD == 3u                         /* Allocate storage for CPU status register       */
     OS_CPU_SR     cpu_sr = 0u;
 #endif
@@ -709,27 +1052,60 @@ OS_FLAGS  OSFlagPost (OS_FLAG_GRP  *pgrp,
         return ((OS_FLAGS)0);
     }
 #endif
-
-    if (rt_object_get_type(&pgrp->pFlagGrp->parent.parent) /* Validate event block type                */
-        != RT_Object_Class_Event) {
+    if (pgrp->OSFlagType != OS_EVENT_TYPE_FLAG) {    /* Make sure we are pointing to an event flag grp */
         *perr = OS_ERR_EVENT_TYPE;
         return ((OS_FLAGS)0);
     }
 
-    rt_err = rt_event_send(pgrp->pFlagGrp, flags);
-    if(rt_err == RT_EOK) {
-        *perr = OS_ERR_NONE;
-    } else {
-        *perr = OS_ERR_FLAG_INVALID_PGRP;
-    }
-
     OS_ENTER_CRITICAL();
-#ifndef PKG_USING_UCOSII_WRAPPER_TINY
-    OSTCBCur->OSTCBFlagsRdy = rt_thread_self()->event_set;
+    switch (opt) {
+        case OS_FLAG_CLR:
+             pgrp->OSFlagFlags &= (OS_FLAGS)~flags;  /* Clear the flags specified in the group         */
+             break;
+
+        case OS_FLAG_SET:
+             pgrp->OSFlagFlags |=  flags;            /* Set   the flags specified in the group         */
+             break;
+
+        default:
+             OS_EXIT_CRITICAL();                     /* INVALID option                                 */
+             *perr = OS_ERR_FLAG_INVALID_OPT;
+             return ((OS_FLAGS)0);
+    }
+    sched = OS_FALSE;                                /* Indicate that we don't need rescheduling       */
+    pnode = (OS_FLAG_NODE *)pgrp->OSFlagWaitList;
+    while (pnode != (OS_FLAG_NODE *)0) {             /* Go through all tasks waiting on event flag(s)  */
+        pnode_next = (OS_FLAG_NODE *)pnode->OSFlagNodeNext;
+        if (OS_FlagTest(pgrp->OSFlagFlags,
+                        pnode->OSFlagNodeFlags,
+                        pnode->OSFlagNodeWaitType,
+                        &flags_rdy) == OS_ERR_NONE) {
+            if (pnode->OSFlagNodeConsume == OS_TRUE) {   /* Consume on behalf of the waiting task      */
+                OS_FlagConsume(pgrp, flags_rdy, pnode->OSFlagNodeWaitType);
+            }
+            OS_FlagTaskRdy(pnode, flags_rdy, OS_STAT_PEND_OK); /* Make task RTR, event(s) Rx'd         */
+            sched = OS_TRUE;                         /* When done we will reschedule                   */
+            if ((pnode_next != (OS_FLAG_NODE *)0) && /* Next node belonged to the same multi-pend?     */
+                (pnode_next->OSFlagNodeFlagGrp == (void *)0)) {
+                pnode_next = (OS_FLAG_NODE *)pgrp->OSFlagWaitList; /* Yes, restart from list head      */
+            }
+        }
+        pnode = pnode_next;
+    }
+#if OS_FLAG_CB_EN > 0u
+    if (pgrp->OSFlagCbList != (void *)0) {           /* Evaluate registered callbacks                  */
+        if (OS_FlagCbPost(pgrp) == OS_TRUE) {
+            sched = OS_TRUE;                         /* Callback task was readied                      */
+        }
+    }
 #endif
-    flags = pgrp->pFlagGrp->set;
+    flags_cur = pgrp->OSFlagFlags;
     OS_EXIT_CRITICAL();
-    return (flags);
+    if (sched == OS_TRUE) {
+        OS_Sched();
+    }
+    *perr = OS_ERR_NONE;
+    return (flags_cur);
 }
 
 
@@ -775,17 +1151,604 @@ OS_FLAGS  OSFlagQuery (OS_FLAG_GRP  *pgrp,
         return ((OS_FLAGS)0);
     }
 #endif
-    if (rt_object_get_type(&pgrp->pFlagGrp->parent.parent) /* Validate event block type                */
-        != RT_Object_Class_Event) {
+    if (pgrp->OSFlagType != OS_EVENT_TYPE_FLAG) { /* Validate event block type                         */
         *perr = OS_ERR_EVENT_TYPE;
         return ((OS_FLAGS)0);
     }
     OS_ENTER_CRITICAL();
-    flags = pgrp->pFlagGrp->set;
+    flags = pgrp->OSFlagFlags;
     OS_EXIT_CRITICAL();
     *perr = OS_ERR_NONE;
     return (flags);                               /* Return the current value of the event flags       */
 }
 #endif
 
+
+/*
+*********************************************************************************************************
+*                               INITIALIZE THE EVENT FLAG MODULE
+*
+* Description: This function is called by uC/OS-II to initialize the event flag module.  Your application
+*              MUST NOT call this function.  In other words, this function is internal to uC/OS-II.
+*
+* Arguments  : none
+*
+* Returns    : none
+*
+* WARNING    : You MUST NOT call this function from your code.  This is an INTERNAL function to uC/OS-II.
+*********************************************************************************************************
+*/
+
+void  OS_FlagInit (void)
+{
+#if OS_FLAG_CB_EN > 0u
+    INT16U  ix;
+
+
+    OS_MemClr((INT8U *)&OSFlagCbTbl[0], sizeof(OSFlagCbTbl));   /* Clear the callback table            */
+    for (ix = 0u; ix < (OS_FLAG_CB_MAX - 1u); ix++) {           /* Init. list of free callbacks        */
+        OSFlagCbTbl[ix].OSFlagCbNext = &OSFlagCbTbl[ix + 1u];
+    }
+    OSFlagCbTbl[OS_FLAG_CB_MAX - 1u].OSFlagCbNext = (OS_FLAG_CB *)0;
+    OSFlagCbFreeList = &OSFlagCbTbl[0];
+    OSFlagCbPendHead    = (OS_FLAG_CB *)0;
+    OSFlagCbPendTail    = (OS_FLAG_CB *)0;
+    OSFlagCbTaskCreated = OS_FALSE;                             /* Created by OSFlagCallbackRegister() */
+    OSTCBPrioTbl[OS_FLAG_CB_TASK_PRIO] = OS_TCB_RESERVED;       /* Reserve the callback task priority  */
+#endif
+}
+
+
+/*
+*********************************************************************************************************
+*                                 TEST THE STATE OF AN EVENT FLAG GROUP
+*
+* Description: This function determines whether 'flags_cur' satisfies the condition described by 'flags'
+*              and 'wait_type'.
+*
+* Arguments  : flags_cur     is the current value of the event flag group.
+*
+*              flags         is the bit pattern the caller is interested in.
+*
+*              wait_type     is one of OS_FLAG_WAIT_??? (without OS_FLAG_CONSUME).
+*
+*              pflags_rdy    receives the flags that satisfy the condition.
+*
+* Returns    : OS_ERR_NONE            the condition is satisfied
+*              OS_ERR_FLAG_NOT_RDY    the condition is not satisfied
+*              OS_ERR_FLAG_WAIT_TYPE  'wait_type' is invalid
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*********************************************************************************************************
+*/
+
+static  INT8U  OS_FlagTest (OS_FLAGS   flags_cur,
+                            OS_FLAGS   flags,
+                            INT8U      wait_type,
+                            OS_FLAGS  *pflags_rdy)
+{
+    OS_FLAGS  flags_rdy;
+    BOOLEAN   rdy;
+
+
+    switch (wait_type) {
+        case OS_FLAG_WAIT_SET_ALL:                         /* See if all required flags are set        */
+             flags_rdy = (OS_FLAGS)(flags_cur & flags);    /* Extract only the bits we want            */
+             rdy       = (flags_rdy == flags) ? OS_TRUE : OS_FALSE;
+             break;
+
+        case OS_FLAG_WAIT_SET_ANY:
+             flags_rdy = (OS_FLAGS)(flags_cur & flags);    /* Extract only the bits we want            */
+             rdy       = (flags_rdy != (OS_FLAGS)0) ? OS_TRUE : OS_FALSE;
+             break;
+
+#if OS_FLAG_WAIT_CLR_EN > 0u
+        case OS_FLAG_WAIT_CLR_ALL:                         /* See if all required flags are cleared    */
+             flags_rdy = (OS_FLAGS)~flags_cur & flags;     /* Extract only the bits we want            */
+             rdy       = (flags_rdy == flags) ? OS_TRUE : OS_FALSE;
+             break;
+
+        case OS_FLAG_WAIT_CLR_ANY:
+             flags_rdy = (OS_FLAGS)~flags_cur & flags;     /* Extract only the bits we want            */
+             rdy       = (flags_rdy != (OS_FLAGS)0) ? OS_TRUE : OS_FALSE;
+             break;
+#endif
+
+        default:
+             *pflags_rdy = (OS_FLAGS)0;
+             return (OS_ERR_FLAG_WAIT_TYPE);
+    }
+    *pflags_rdy = flags_rdy;
+    if (rdy == OS_TRUE) {
+        return (OS_ERR_NONE);
+    }
+    return (OS_ERR_FLAG_NOT_RDY);
+}
+
+
+/*
+*********************************************************************************************************
+*                                   CONSUME FLAGS OF AN EVENT FLAG GROUP
+*
+* Description: This function undoes the flags that satisfied a wait condition: SET flags are cleared and
+*              CLR flags are set.
+*
+* Arguments  : pgrp          is a pointer to the event flag group.
+*
+*              flags_rdy     are the flags to consume.
+*
+*              wait_type     is the wait type that was satisfied (without OS_FLAG_CONSUME).
+*
+* Returns    : none
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*              2) Interrupts are assumed to be disabled when this function is called.
+*********************************************************************************************************
+*/
+
+static  void  OS_FlagConsume (OS_FLAG_GRP  *pgrp,
+                              OS_FLAGS      flags_rdy,
+                              INT8U         wait_type)
+{
+    if ((wait_type == OS_FLAG_WAIT_SET_ALL) ||
+        (wait_type == OS_FLAG_WAIT_SET_ANY)) {
+        pgrp->OSFlagFlags &= (OS_FLAGS)~flags_rdy;         /* Clear ONLY the flags that we wanted      */
+    } else {
+        pgrp->OSFlagFlags |=  flags_rdy;                   /* Set   ONLY the flags that we wanted      */
+    }
+}
+
+
+
+
+/*
+*********************************************************************************************************
+*                                  ADD A NODE TO AN EVENT FLAG WAIT LIST
+*
+* Description: This function is internal to uC/OS-II and is used to add a node describing the current
+*              task's wait condition to the wait list of an event flag group.
+*
+* Arguments  : pgrp          is a pointer to the desired event flag group.
+*
+*              pnode         is a pointer to a structure which contains data about the task waiting for
+*                            event flag bit(s) to be set.
+*
+*              flags         Is a bit pattern indicating which bit(s) (i.e. flags) you wish to check.
+*
+*              wait_type     specifies whether you want ALL bits to be set/cleared or ANY of the bits
+*                            to be set/cleared (see OSFlagPend()).
+*
+*              consume       indicates whether the flags are to be consumed when the task is readied.
+*
+* Returns    : none
+*
+* Called by  : OSFlagPend()       OS_FLAG.C
+*              OSFlagPendMulti()  OS_FLAG.C
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*              2) Interrupts are assumed to be disabled when this function is called.
+*********************************************************************************************************
+*/
+
+static  void  OS_FlagLink (OS_FLAG_GRP  *pgrp,
+                           OS_FLAG_NODE *pnode,
+                           OS_FLAGS      flags,
+                           INT8U         wait_type,
+                           BOOLEAN       consume)
+{
+    OS_FLAG_NODE  *pnode_next;
+
+
+    pnode->OSFlagNodeFlags    = flags;                /* Save the flags that we need to wait for       */
+    pnode->OSFlagNodeWaitType = wait_type;            /* Save the type of wait we are doing            */
+    pnode->OSFlagNodeConsume  = consume;              /* Save whether flags are consumed when readied  */
+    pnode->OSFlagNodeRdy      = OS_FALSE;
+    pnode->OSFlagNodeTCB      = (void *)OSTCBCur;     /* Link to task's TCB                            */
+    pnode->OSFlagNodeNext     = pgrp->OSFlagWaitList; /* Add node at beginning of event flag wait list */
+    pnode->OSFlagNodePrev     = (void *)0;
+    pnode->OSFlagNodeFlagGrp  = (void *)pgrp;         /* Link to Event Flag Group                      */
+    pnode_next                = (OS_FLAG_NODE *)pgrp->OSFlagWaitList;
+    if (pnode_next != (void *)0) {                    /* Is this the first NODE to insert?             */
+        pnode_next->OSFlagNodePrev = pnode;           /* No, link in doubly linked list                */
+    }
+    pgrp->OSFlagWaitList = (void *)pnode;
+}
+
+
+/*
+*********************************************************************************************************
+*                          SUSPEND TASK UNTIL EVENT FLAG(s) RECEIVED OR TIMEOUT OCCURS
+*
+* Description: This function is internal to uC/OS-II and is used to put a task to sleep until the desired
+*              event flag bit(s) are set.
+*
+* Arguments  : pnodes        is a pointer to the array of nodes already linked by OS_FlagLink().
+*
+*              n             is the number of nodes in the array.
+*
+*              timeout       is the desired amount of time that the task will wait for the event flag
+*                            bit(s) to be set (0 means forever).
+*
+* Returns    : none
+*
+* Called by  : OSFlagPend()       OS_FLAG.C
+*              OSFlagPendMulti()  OS_FLAG.C
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*              2) Interrupts are assumed to be disabled when this function is called.  The RT-Thread
+*                 thread is suspended here and its built-in timer is used for the timeout; the caller
+*                 must call OS_Sched() once interrupts are enabled again.
+*********************************************************************************************************
+*/
+
+static  void  OS_FlagBlock (OS_FLAG_NODE *pnodes,
+                            INT8U         n,
+                            INT32U        timeout)
+{
+    rt_thread_t    thread;
+    rt_tick_t      tick;
+
+
+    OSTCBCur->OSTCBStat        |= OS_STAT_FLAG;
+    OSTCBCur->OSTCBStatPend     = OS_STAT_PEND_OK;
+#ifndef PKG_USING_UCOSII_WRAPPER_TINY
+    OSTCBCur->OSTCBDly          = timeout;            /* Store timeout in task's TCB                   */
+#endif
+    OSTCBCur->OSTCBFlagNode     = pnodes;             /* TCB to link to node(s)                        */
+    OSTCBCur->OSTCBFlagNodeCnt  = n;
+
+    thread        = rt_thread_self();                 /* Suspend current task                          */
+    thread->error = RT_EOK;
+    rt_thread_suspend(thread);
+    if (timeout > 0u) {                               /* 0为永久等待                                   */
+        tick = (rt_tick_t)timeout;
+        rt_timer_control(&(thread->thread_timer), RT_TIMER_CTRL_SET_TIME, &tick);
+        rt_timer_start(&(thread->thread_timer));
+    }
+}
+
+
+/*
+*********************************************************************************************************
+*                                   FINISH WAITING ON EVENT FLAG(s)
+*
+* Description: This function is internal to uC/OS-II and is called by the pending task once it runs again
+*              to find out why it was readied.
+*
+* Arguments  : pnodes        is a pointer to the array of nodes the task was waiting on.
+*
+*              n             is the number of nodes in the array.
+*
+*              pflags_rdy    receives the flags that made the task ready (0 upon timeout or abort).
+*
+*              pwhich        receives the index of the node that made the task ready ('n' if none).
+*
+* Returns    : OS_ERR_NONE        the wait condition was met
+*              OS_ERR_TIMEOUT     the wait timed out
+*              OS_ERR_PEND_ABORT  the wait was aborted
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*********************************************************************************************************
+*/
+
+static  INT8U  OS_FlagPendEnd (OS_FLAG_NODE *pnodes,
+                               INT8U         n,
+                               OS_FLAGS     *pflags_rdy,
+                               INT8U        *pwhich)
+{
+    INT8U      pend_stat;
+    INT8U      i;
+#if OS_CRITICAL_METHOD == 3u                               /* Allocate storage for CPU status register */
+    OS_CPU_SR  cpu_sr = 0u;
+#endif
+
+
+    OS_ENTER_CRITICAL();
+    pend_stat = OSTCBCur->OSTCBStatPend;
+    OS_FlagUnlink(pnodes);                                 /* Timeout or forced resume: still linked   */
+    OSTCBCur->OSTCBStat     = OS_STAT_RDY;                 /* Make task ready-to-run                   */
+    OSTCBCur->OSTCBStatPend = OS_STAT_PEND_OK;             /* Clear pend  status                       */
+    *pwhich                 = n;
+    if (pend_stat == OS_STAT_PEND_OK) {
+        for (i = 0u; i < n; i++) {                         /* Find the node that made us ready         */
+            if (pnodes[i].OSFlagNodeRdy == OS_TRUE) {
+                *pwhich = i;
+                break;
+            }
+        }
+    }
+    if (*pwhich < n) {
+        *pflags_rdy = OSTCBCur->OSTCBFlagsRdy;             /* Flags (already consumed) by the poster   */
+        OS_EXIT_CRITICAL();
+        return (OS_ERR_NONE);
+    }
+    *pflags_rdy = (OS_FLAGS)0;
+    OS_EXIT_CRITICAL();
+    if (pend_stat == OS_STAT_PEND_ABORT) {
+        return (OS_ERR_PEND_ABORT);                        /* Indicate that we aborted   waiting       */
+    }
+    return (OS_ERR_TIMEOUT);                               /* Indicate that we timed-out waiting       */
+}
+
+
+/*
+*********************************************************************************************************
+*                                    MAKE TASK READY-TO-RUN, EVENT(s) OCCURRED
+*
+* Description: This function is internal to uC/OS-II and is used to make a task ready-to-run because the
+*              desired event flag bits have been set or the wait was aborted.
+*
+* Arguments  : pnode         is a pointer to a structure which contains data about the task waiting for
+*                            event flag bit(s) to be set.
+*
+*              flags_rdy     contains the bit pattern of the event flags that cause the task to become
+*                            ready-to-run.
+*
+*              pend_stat     is used to indicate the readied task's pending status:
+*
+*                            OS_STAT_PEND_OK      Task ready due to a post, not a timeout or abort.
+*                            OS_STAT_PEND_ABORT   Task ready due to an abort (or deletion).
+*
+* Returns    : none
+*
+* Called by  : OSFlagPost() OS_FLAG.C
+*              OSFlagDel()  OS_FLAG.C
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*              2) Interrupts are assumed to be disabled when this function is called.
+*              3) All the nodes of the task (see OSFlagPendMulti()) are removed from their wait lists.
+*              4) The caller is responsible for calling OS_Sched().
+*********************************************************************************************************
+*/
+
+static  void  OS_FlagTaskRdy (OS_FLAG_NODE *pnode,
+                              OS_FLAGS      flags_rdy,
+                              INT8U         pend_stat)
+{
+    OS_TCB   *ptcb;
+
+
+    ptcb                 = (OS_TCB *)pnode->OSFlagNodeTCB; /* Point to TCB of waiting task             */
+    ptcb->OSTCBFlagsRdy  = flags_rdy;
+    ptcb->OSTCBStat     &= (INT8U)~(INT8U)(OS_STAT_FLAG | OS_STAT_MULTI);
+    ptcb->OSTCBStatPend  = pend_stat;
+#ifndef PKG_USING_UCOSII_WRAPPER_TINY
+    ptcb->OSTCBDly       = 0u;
+#endif
+    pnode->OSFlagNodeRdy = OS_TRUE;                        /* Remember which node made the task ready  */
+    OS_FlagUnlink(ptcb->OSTCBFlagNode);                    /* Remove ALL the task's nodes              */
+    if ((ptcb->OSTCBStat & OS_STAT_SUSPEND) == OS_STAT_RDY) { /* Put task into ready list              */
+        rt_thread_resume(&ptcb->OSTask);
+    }
+}
+
+
+/*
+*********************************************************************************************************
+*                                UNLINK EVENT FLAG NODE FROM WAITING LIST
+*
+* Description: This function is internal to uC/OS-II and is used to unlink event flag node(s) from the
+*              lists of tasks waiting for the event flag(s).
+*
+* Arguments  : pnode         is a pointer to a structure which contains data about the task waiting for
+*                            event flag bit(s) to be set.  If 'pnode' is the first node of the task (i.e.
+*                            the one held in .OSTCBFlagNode) all the task's nodes are unlinked.
+*
+* Returns    : none
+*
+* Called by  : OS_FlagTaskRdy() OS_FLAG.C
+*              OS_FlagPendEnd() OS_FLAG.C
+*              OSTaskDel()      OS_TASK.C
+*
+* Note(s)    : 1) This function assumes that interrupts are disabled.
+*              2) This function is INTERNAL to uC/OS-II and your application should not call it.
+*              3) Unlinking a node that is no longer in a wait list has no effect.
+*********************************************************************************************************
+*/
+
+void  OS_FlagUnlink (OS_FLAG_NODE *pnode)
+{
+    OS_TCB       *ptcb;
+    OS_FLAG_GRP  *pgrp;
+    OS_FLAG_NODE *pnode_prev;
+    OS_FLAG_NODE *pnode_next;
+    INT8U         n;
+
+
+    if (pnode == (OS_FLAG_NODE *)0) {
+        return;
+    }
+    ptcb = (OS_TCB *)pnode->OSFlagNodeTCB;
+    n    = 1u;
+    if (ptcb->OSTCBFlagNode == pnode) {                    /* First node: unlink the whole array       */
+        n                      = ptcb->OSTCBFlagNodeCnt;
+        ptcb->OSTCBFlagNode    = (OS_FLAG_NODE *)0;
+        ptcb->OSTCBFlagNodeCnt = 0u;
+    }
+    while (n > 0u) {
+        pgrp = (OS_FLAG_GRP *)pnode->OSFlagNodeFlagGrp;
+        if (pgrp != (OS_FLAG_GRP *)0) {                    /* Node still in a wait list?               */
+            pnode_prev = (OS_FLAG_NODE *)pnode->OSFlagNodePrev;
+            pnode_next = (OS_FLAG_NODE *)pnode->OSFlagNodeNext;
+            if (pnode_prev == (OS_FLAG_NODE *)0) {         /* Is it first node in wait list?           */
+                pgrp->OSFlagWaitList = (void *)pnode_next; /*      Update list for new 1st node        */
+            } else {                                       /* No,  A node somewhere in the list        */
+                pnode_prev->OSFlagNodeNext = pnode_next;   /*      Link around the node to unlink      */
+            }
+            if (pnode_next != (OS_FLAG_NODE *)0) {         /* Was this the LAST node?                  */
+                pnode_next->OSFlagNodePrev = pnode_prev;   /* No, Link around current node             */
+            }
+            pnode->OSFlagNodeFlagGrp = (void *)0;          /* Mark node as no longer in a wait list    */
+        }
+        pnode++;
+        n--;
+    }
+}
+
+/*
+*********************************************************************************************************
+*                                   EVALUATE THE CALLBACKS OF A GROUP
+*
+* Description: This function is called by OSFlagPost() to run the inline callbacks whose condition is met
+*              and to queue the deferred ones for the callback task.
+*
+* Arguments  : pgrp          is a pointer to the event flag group that was posted.
+*
+* Returns    : OS_TRUE       if the callback task was readied
+*              OS_FALSE      otherwise
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*              2) Interrupts are assumed to be disabled when this function is called.
+*********************************************************************************************************
+*/
+
+#if OS_FLAG_CB_EN > 0u
+static  BOOLEAN  OS_FlagCbPost (OS_FLAG_GRP *pgrp)
+{
+    OS_FLAG_CB  *pcb;
+    OS_FLAG_CB  *pcb_next;
+    OS_FLAGS     flags_rdy;
+    INT8U        wait_type;
+    BOOLEAN      rdy;
+
+
+    rdy = OS_FALSE;
+    pcb = (OS_FLAG_CB *)pgrp->OSFlagCbList;
+    while (pcb != (OS_FLAG_CB *)0) {
+        pcb_next  = pcb->OSFlagCbNext;
+        wait_type = (INT8U)(pcb->OSFlagCbWaitType & (INT8U)~(INT8U)(OS_FLAG_CONSUME | OS_FLAG_CB_INLINE));
+        if (OS_FlagTest(pgrp->OSFlagFlags,
+                        pcb->OSFlagCbFlags,
+                        wait_type,
+                        &flags_rdy) == OS_ERR_NONE) {
+            if ((pcb->OSFlagCbWaitType & OS_FLAG_CONSUME) != 0u) {
+                OS_FlagConsume(pgrp, flags_rdy, wait_type);
+            }
+            if ((pcb->OSFlagCbWaitType & OS_FLAG_CB_INLINE) != 0u) {
+                (*pcb->OSFlagCbFnct)(pgrp, flags_rdy, pcb->OSFlagCbArg); /* Run right away             */
+            } else {
+                pcb->OSFlagCbFlagsRdy |= flags_rdy;
+                if (pcb->OSFlagCbPend == OS_FALSE) {       /* Queue for the callback task              */
+                    pcb->OSFlagCbPend     = OS_TRUE;
+                    pcb->OSFlagCbPendNext = (OS_FLAG_CB *)0;
+                    if (OSFlagCbPendTail == (OS_FLAG_CB *)0) {
+                        OSFlagCbPendHead                   = pcb;
+                    } else {
+                        OSFlagCbPendTail->OSFlagCbPendNext = pcb;
+                    }
+                    OSFlagCbPendTail      = pcb;
+                }
+                rdy = OS_TRUE;
+            }
+        }
+        pcb = pcb_next;
+    }
+    if (rdy == OS_TRUE) {
+        rt_thread_resume(&OSFlagCbTask);                   /* No effect if the task is already ready   */
+    }
+    return (rdy);
+}
+
+
+/*
+*********************************************************************************************************
+*                                       RELEASE A FLAG CALLBACK
+*
+* Description: This function removes a callback from the queue of the callback task (if needed) and
+*              returns it to the free list.  The callback must already be unlinked from its group.
+*
+* Arguments  : pcb           is a pointer to the callback to release.
+*
+* Returns    : none
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*              2) Interrupts are assumed to be disabled when this function is called.
+*********************************************************************************************************
+*/
+
+static  void  OS_FlagCbFree (OS_FLAG_CB *pcb)
+{
+    OS_FLAG_CB  *pcb_prev;
+    OS_FLAG_CB  *pcb_scan;
+
+
+    if (pcb->OSFlagCbPend == OS_TRUE) {                    /* Cancel a deferred call that didn't run   */
+        pcb_prev = (OS_FLAG_CB *)0;
+        pcb_scan = OSFlagCbPendHead;
+        while (pcb_scan != pcb) {
+            pcb_prev = pcb_scan;
+            pcb_scan = pcb_scan->OSFlagCbPendNext;
+        }
+        if (pcb_prev == (OS_FLAG_CB *)0) {
+            OSFlagCbPendHead           = pcb->OSFlagCbPendNext;
+        } else {
+            pcb_prev->OSFlagCbPendNext = pcb->OSFlagCbPendNext;
+        }
+        if (OSFlagCbPendTail == pcb) {
+            OSFlagCbPendTail           = pcb_prev;
+        }
+    }
+    pcb->OSFlagCbGrp      = (OS_FLAG_GRP *)0;
+    pcb->OSFlagCbFnct     = (OS_FLAG_CALLBACK)0;
+    pcb->OSFlagCbArg      = (void *)0;
+    pcb->OSFlagCbPend     = OS_FALSE;
+    pcb->OSFlagCbPendNext = (OS_FLAG_CB *)0;
+    pcb->OSFlagCbNext     = OSFlagCbFreeList;              /* Return callback to free list             */
+    OSFlagCbFreeList      = pcb;
+}
+
+
+/*
+*********************************************************************************************************
+*                                     DEFERRED FLAG CALLBACK TASK
+*
+* Description: This task runs the callbacks queued by OSFlagPost(), one at a time and with interrupts
+*              enabled.  It suspends itself when the queue is empty.
+*
+* Arguments  : p_arg         is not used.
+*
+* Returns    : none
+*
+* Note(s)    : 1) This task is an RT-Thread thread and does not use a uC/OS-II TCB or priority.
+*********************************************************************************************************
+*/
+
+static  void  OS_FlagCbTask (void *p_arg)
+{
+    OS_FLAG_CB        *pcb;
+    OS_FLAG_GRP       *pgrp;
+    OS_FLAG_CALLBACK   fnct;
+    void              *parg;
+    OS_FLAGS           flags_rdy;
+#if OS_CRITICAL_METHOD == 3u                               /* Allocate storage for CPU status register */
+    OS_CPU_SR          cpu_sr = 0u;
+#endif
+
+
+    (void)p_arg;
+    for (;;) {
+        OS_ENTER_CRITICAL();
+        pcb = OSFlagCbPendHead;
+        if (pcb == (OS_FLAG_CB *)0) {                      /* Nothing to do, wait for OSFlagPost()     */
+            rt_thread_suspend(rt_thread_self());
+            OS_EXIT_CRITICAL();
+            rt_schedule();
+            continue;
+        }
+        OSFlagCbPendHead = pcb->OSFlagCbPendNext;          /* Remove callback from the queue           */
+        if (OSFlagCbPendHead == (OS_FLAG_CB *)0) {
+            OSFlagCbPendTail = (OS_FLAG_CB *)0;
+        }
+        pcb->OSFlagCbPend     = OS_FALSE;
+        pcb->OSFlagCbPendNext = (OS_FLAG_CB *)0;
+        pgrp                  = pcb->OSFlagCbGrp;
+        fnct                  = pcb->OSFlagCbFnct;
+        parg                  = pcb->OSFlagCbArg;
+        flags_rdy             = pcb->OSFlagCbFlagsRdy;
+        pcb->OSFlagCbFlagsRdy = (OS_FLAGS)0;
+        OS_EXIT_CRITICAL();
+        (*fnct)(pgrp, flags_rdy, parg);                    /* Run the callback with interrupts enabled */
+    }
+}
+#endif
 #endif
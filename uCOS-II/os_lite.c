@@ -0,0 +1,506 @@
+/*
+ * Copyright (c) 2021, Meco Jianting Man <jiantingman@foxmail.com>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+/*
+*********************************************************************************************************
+*                                              uC/OS-II
+*                                        The Real-Time Kernel
+*
+*                    Copyright 1992-2020 Silicon Laboratories Inc. www.silabs.com
+*
+*                                 SPDX-License-Identifier: APACHE-2.0
+*
+*               This software is subject to an open source license and is distributed by
+*                Silicon Laboratories Inc. pursuant to the terms of the Apache License,
+*                    Version 2.0 available at www.apache.org/licenses/LICENSE-2.0.
+*
+*********************************************************************************************************
+*/
+
+
+/*
+*********************************************************************************************************
+*
+*                                         LITE TASK MANAGEMENT
+*
+* Filename : os_lite.c
+* Version  : V2.93.00
+*********************************************************************************************************
+* Note(s)  : 1) A lite task is a run-to-completion function described by an OS_LITE.  All the lite tasks
+*               created at a given priority are run, one after the other, by a single dispatcher task
+*               and share its stack, so a lite task costs sizeof(OS_LITE) bytes instead of a TCB and a
+*               stack.
+*
+*            2) A lite task waits with the OS_LITE_xxx() macros.  A wait which cannot complete returns
+*               from the lite task function; the next time the dispatcher calls it, it resumes right at
+*               the wait (the resume point is the source line, saved in OSLiteLc).  Local variables are
+*               therefore NOT preserved across a wait (keep the state in the object 'OSLiteArg' points
+*               to) and a lite task must not use a 'switch' statement around a wait.
+*
+*            3) A lite task must never call a blocking service (OSTimeDly(), OSSemPend() ...): it would
+*               block the dispatcher and every other lite task at that priority.
+*
+*            4) The dispatcher polls the objects waited on once per tick.  When all its lite tasks are
+*               delayed it sleeps until the nearest delay expires.
+*********************************************************************************************************
+*/
+
+#include "ucos_ii.h"
+
+#if OS_TASK_LITE_EN > 0u
+
+/*
+*********************************************************************************************************
+*                                           LOCAL DATA TYPES
+*********************************************************************************************************
+*/
+
+typedef struct os_lite_disp {               /* Dispatcher running the lite tasks of a priority         */
+    OS_LITE             *OSLiteDispList;    /* List of the lite tasks to run                           */
+    struct rt_semaphore  OSLiteDispSem;     /* Wakes the dispatcher when a lite task is created        */
+    INT8U                OSLiteDispPrio;    /* Priority of the dispatcher task                         */
+    BOOLEAN              OSLiteDispUsed;    /* Entry is in use                                         */
+} OS_LITE_DISP;
+
+
+/*
+*********************************************************************************************************
+*                                           LOCAL VARIABLES
+*********************************************************************************************************
+*/
+
+static  OS_LITE_DISP  OSLiteDispTbl[OS_TASK_LITE_DISP_MAX];                        /* Dispatchers    */
+static  OS_STK        OSLiteDispStk[OS_TASK_LITE_DISP_MAX][OS_TASK_LITE_STK_SIZE];  /* Their stacks   */
+
+
+/*
+*********************************************************************************************************
+*                                          LOCAL PROTOTYPES
+*********************************************************************************************************
+*/
+
+static  void     OS_LiteTask     (void     *p_arg);
+
+static  BOOLEAN  OS_LiteTimeout  (OS_LITE  *plite);
+
+
+/*
+*********************************************************************************************************
+*                                          CREATE A LITE TASK
+*
+* Description: This function is called to create a lite task, a run-to-completion function that is run by
+*              the dispatcher task at priority 'prio'.  The dispatcher is created with the first lite task
+*              at that priority.
+*
+* Arguments  : plite     is a pointer to the OS_LITE describing the lite task.  It must remain valid until
+*                        the lite task ends.
+*
+*              fnct      is the lite task function.  It is called with 'plite' and returns OS_LITE_ENDED
+*                        (through OS_LITE_END()) when the lite task is done or OS_LITE_WAITING when it
+*                        waits.
+*
+*              p_arg     is an argument passed to the lite task in plite->OSLiteArg.
+*
+*              prio      is the priority of the dispatcher task.  It must be free or already used by lite
+*                        tasks.
+*
+* Returns    : OS_ERR_NONE              if the lite task was created.
+*              OS_ERR_PDATA_NULL        if 'plite' or 'fnct' is a NULL pointer.
+*              OS_ERR_PRIO_INVALID      if the priority you specify is higher that the maximum allowed
+*                                       (i.e. >= OS_LOWEST_PRIO)
+*              OS_ERR_TASK_CREATE_ISR   if you tried to create a lite task from an ISR.
+*              OS_ERR_PRIO_EXIST        if 'prio' is used by a task which is not a dispatcher.
+*              OS_ERR_TASK_LITE_FULL    if OS_TASK_LITE_DISP_MAX priorities already run lite tasks.
+*              Any error returned by OSTaskCreateExt() when creating the dispatcher.
+*
+* Note(s)    : 1) An OS_LITE can be reused for a new lite task once the previous one has ended.
+*********************************************************************************************************
+*/
+
+INT8U  OSTaskCreateLite (OS_LITE       *plite,
+                         OS_LITE_FNCT   fnct,
+                         void          *p_arg,
+                         INT8U          prio)
+{
+    OS_LITE_DISP  *pdisp;
+    OS_LITE_DISP  *pfree;
+    INT8U          i;
+    INT8U          err;
+#if OS_CRITICAL_METHOD == 3u                     /* Allocate storage for CPU status register           */
+    OS_CPU_SR      cpu_sr = 0u;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0u
+    if (plite == (OS_LITE *)0) {                 /* Validate arguments                                 */
+        return (OS_ERR_PDATA_NULL);
+    }
+    if (fnct == (OS_LITE_FNCT)0) {
+        return (OS_ERR_PDATA_NULL);
+    }
+    if (prio >= OS_LOWEST_PRIO) {
+        return (OS_ERR_PRIO_INVALID);
+    }
+#endif
+    if (OSIntNesting > 0u) {                     /* Make sure we don't create from within an ISR       */
+        return (OS_ERR_TASK_CREATE_ISR);
+    }
+    plite->OSLiteFnct      = fnct;
+    plite->OSLiteArg       = p_arg;
+    plite->OSLiteNext      = (OS_LITE *)0;
+    plite->OSLiteEventPtr  = (void *)0;
+    plite->OSLiteMsg       = (void *)0;
+    plite->OSLiteTickStart = 0u;
+    plite->OSLiteTicks     = 0u;
+    plite->OSLiteLc        = 0u;                 /* Start at the top of the function                   */
+    plite->OSLiteErr       = OS_ERR_NONE;
+    plite->OSLiteRdy       = OS_FALSE;
+
+    OSSchedLock();                               /* Serialize the creation of the dispatchers          */
+    pdisp = (OS_LITE_DISP *)0;
+    pfree = (OS_LITE_DISP *)0;
+    for (i = 0u; i < OS_TASK_LITE_DISP_MAX; i++) {
+        if (OSLiteDispTbl[i].OSLiteDispUsed == OS_FALSE) {
+            if (pfree == (OS_LITE_DISP *)0) {
+                pfree = &OSLiteDispTbl[i];
+            }
+        } else if (OSLiteDispTbl[i].OSLiteDispPrio == prio) {
+            pdisp = &OSLiteDispTbl[i];
+            break;
+        }
+    }
+    if (pdisp == (OS_LITE_DISP *)0) {            /* No dispatcher at this priority yet                 */
+        if (OSTCBPrioTbl[prio] != (OS_TCB *)0) {
+            OSSchedUnlock();
+            return (OS_ERR_PRIO_EXIST);
+        }
+        if (pfree == (OS_LITE_DISP *)0) {
+            OSSchedUnlock();
+            return (OS_ERR_TASK_LITE_FULL);
+        }
+        pdisp = pfree;
+        i     = (INT8U)(pdisp - &OSLiteDispTbl[0]);
+        pdisp->OSLiteDispList = (OS_LITE *)0;
+        pdisp->OSLiteDispPrio = prio;
+        rt_sem_init(&pdisp->OSLiteDispSem, "uCLite", 0u, RT_IPC_FLAG_FIFO);
+#if OS_STK_GROWTH == 1u
+        err = OSTaskCreateExt(OS_LiteTask,
+                              (void *)pdisp,
+                              &OSLiteDispStk[i][OS_TASK_LITE_STK_SIZE - 1u],   /* Set Top-Of-Stack           */
+                              prio,
+                              (INT16U)prio,
+                              &OSLiteDispStk[i][0],                            /* Set Bottom-Of-Stack        */
+                              OS_TASK_LITE_STK_SIZE,
+                              (void *)0,
+                              OS_TASK_OPT_STK_CHK | OS_TASK_OPT_STK_CLR);
+#else
+        err = OSTaskCreateExt(OS_LiteTask,
+                              (void *)pdisp,
+                              &OSLiteDispStk[i][0],                            /* Set Top-Of-Stack           */
+                              prio,
+                              (INT16U)prio,
+                              &OSLiteDispStk[i][OS_TASK_LITE_STK_SIZE - 1u],   /* Set Bottom-Of-Stack        */
+                              OS_TASK_LITE_STK_SIZE,
+                              (void *)0,
+                              OS_TASK_OPT_STK_CHK | OS_TASK_OPT_STK_CLR);
+#endif
+        if (err != OS_ERR_NONE) {
+            rt_sem_detach(&pdisp->OSLiteDispSem);
+            OSSchedUnlock();
+            return (err);
+        }
+#if OS_TASK_NAME_EN > 0u
+        OSTaskNameSet(prio, (INT8U *)(void *)"uC/OS-II Lite", &err);
+#endif
+        pdisp->OSLiteDispUsed = OS_TRUE;
+    }
+    OS_ENTER_CRITICAL();
+    plite->OSLiteNext     = pdisp->OSLiteDispList;   /* Insert at the head of the dispatcher's list    */
+    pdisp->OSLiteDispList = plite;
+    OS_EXIT_CRITICAL();
+    OSSchedUnlock();
+    rt_sem_release(&pdisp->OSLiteDispSem);       /* Have the dispatcher run the new lite task          */
+    return (OS_ERR_NONE);
+}
+
+
+/*
+*********************************************************************************************************
+*                                       CHECK IF A DELAY HAS EXPIRED
+*
+* Description: This function is called by OS_LITE_DLY() to see if the delay of a lite task has expired.
+*
+* Arguments  : plite     is a pointer to the lite task.
+*
+* Returns    : OS_TRUE   if the delay has expired.
+*              OS_FALSE  otherwise.
+*********************************************************************************************************
+*/
+
+BOOLEAN  OS_LiteDlyDone (OS_LITE  *plite)
+{
+    if ((INT32U)(rt_tick_get() - plite->OSLiteTickStart) < plite->OSLiteTicks) {
+        return (OS_FALSE);
+    }
+    plite->OSLiteRdy = OS_TRUE;
+    return (OS_TRUE);
+}
+
+
+/*
+*********************************************************************************************************
+*                                      CHECK A LITE TASK SEMAPHORE WAIT
+*
+* Description: This function is called by OS_LITE_PEND_SEM() to try to obtain the semaphore a lite task is
+*              waiting on.
+*
+* Arguments  : plite     is a pointer to the lite task.
+*
+* Returns    : OS_TRUE   if the wait is over, plite->OSLiteErr is then set to:
+*                           OS_ERR_NONE     the semaphore was obtained.
+*                           OS_ERR_TIMEOUT  the semaphore was not obtained within the timeout.
+*              OS_FALSE  if the lite task must keep waiting.
+*********************************************************************************************************
+*/
+
+#if (OS_SEM_EN > 0u) && (OS_SEM_ACCEPT_EN > 0u)
+BOOLEAN  OS_LitePendSem (OS_LITE  *plite)
+{
+    if (OSSemAccept((OS_EVENT *)plite->OSLiteEventPtr) > 0u) {
+        plite->OSLiteEventPtr = (void *)0;
+        plite->OSLiteErr      = OS_ERR_NONE;
+        plite->OSLiteRdy      = OS_TRUE;
+        return (OS_TRUE);
+    }
+    return (OS_LiteTimeout(plite));
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                    CHECK A LITE TASK MESSAGE QUEUE WAIT
+*
+* Description: This function is called by OS_LITE_PEND_Q() to try to obtain a message from the queue a lite
+*              task is waiting on.
+*
+* Arguments  : plite     is a pointer to the lite task.
+*
+* Returns    : OS_TRUE   if the wait is over, plite->OSLiteErr is then set to:
+*                           OS_ERR_NONE       a message was received in plite->OSLiteMsg.
+*                           OS_ERR_TIMEOUT    no message was received within the timeout.
+*                           OS_ERR_EVENT_TYPE the object is not a message queue.
+*              OS_FALSE  if the lite task must keep waiting.
+*********************************************************************************************************
+*/
+
+#if (OS_Q_EN > 0u) && (OS_Q_ACCEPT_EN > 0u)
+BOOLEAN  OS_LitePendQ (OS_LITE  *plite)
+{
+    void   *pmsg;
+    INT8U   err;
+
+
+    pmsg = OSQAccept((OS_EVENT *)plite->OSLiteEventPtr, &err);
+    if (err != OS_ERR_Q_EMPTY) {                 /* Message received or invalid object                 */
+        plite->OSLiteEventPtr = (void *)0;
+        plite->OSLiteMsg      = pmsg;
+        plite->OSLiteErr      = err;
+        plite->OSLiteRdy      = OS_TRUE;
+        return (OS_TRUE);
+    }
+    return (OS_LiteTimeout(plite));
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                      CHECK A LITE TASK MAILBOX WAIT
+*
+* Description: This function is called by OS_LITE_PEND_MBOX() to try to obtain the message of the mailbox a
+*              lite task is waiting on.
+*
+* Arguments  : plite     is a pointer to the lite task.
+*
+* Returns    : OS_TRUE   if the wait is over, plite->OSLiteErr is then set to:
+*                           OS_ERR_NONE     a message was received in plite->OSLiteMsg.
+*                           OS_ERR_TIMEOUT  no message was received within the timeout.
+*              OS_FALSE  if the lite task must keep waiting.
+*********************************************************************************************************
+*/
+
+#if (OS_MBOX_EN > 0u) && (OS_MBOX_ACCEPT_EN > 0u)
+BOOLEAN  OS_LitePendMbox (OS_LITE  *plite)
+{
+    void  *pmsg;
+
+
+    pmsg = OSMboxAccept((OS_EVENT *)plite->OSLiteEventPtr);
+    if (pmsg != (void *)0) {
+        plite->OSLiteEventPtr = (void *)0;
+        plite->OSLiteMsg      = pmsg;
+        plite->OSLiteErr      = OS_ERR_NONE;
+        plite->OSLiteRdy      = OS_TRUE;
+        return (OS_TRUE);
+    }
+    return (OS_LiteTimeout(plite));
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                          START A LITE TASK WAIT
+*
+* Description: This function is called by the OS_LITE_xxx() macros to record what a lite task waits for.
+*
+* Arguments  : plite     is a pointer to the lite task.
+*
+*              pevent    is the object waited on, or a NULL pointer for a delay.
+*
+*              ticks     is the delay, or the timeout of the wait (0 means wait forever).
+*
+* Returns    : none
+*********************************************************************************************************
+*/
+
+void  OS_LiteWaitStart (OS_LITE  *plite,
+                        void     *pevent,
+                        INT32U    ticks)
+{
+    plite->OSLiteEventPtr  = pevent;
+    plite->OSLiteMsg       = (void *)0;
+    plite->OSLiteTickStart = (INT32U)rt_tick_get();
+    plite->OSLiteTicks     = ticks;
+    plite->OSLiteErr       = OS_ERR_NONE;
+}
+
+
+/*
+*********************************************************************************************************
+*                                     CHECK FOR A LITE TASK WAIT TIMEOUT
+*
+* Description: This function is called when the object a lite task waits on is not available, to see if the
+*              wait timed out.
+*
+* Arguments  : plite     is a pointer to the lite task.
+*
+* Returns    : OS_TRUE   if the wait timed out (plite->OSLiteErr is set to OS_ERR_TIMEOUT).
+*              OS_FALSE  otherwise.
+*********************************************************************************************************
+*/
+
+static  BOOLEAN  OS_LiteTimeout (OS_LITE  *plite)
+{
+    if (plite->OSLiteTicks == 0u) {              /* 0 means wait forever                               */
+        return (OS_FALSE);
+    }
+    if ((INT32U)(rt_tick_get() - plite->OSLiteTickStart) < plite->OSLiteTicks) {
+        return (OS_FALSE);
+    }
+    plite->OSLiteEventPtr = (void *)0;
+    plite->OSLiteErr      = OS_ERR_TIMEOUT;
+    plite->OSLiteRdy      = OS_TRUE;
+    return (OS_TRUE);
+}
+
+
+/*
+*********************************************************************************************************
+*                                        INITIALIZE THE DISPATCHERS
+*
+* Description: This function is called by OSInit() to initialize the lite task dispatcher table.
+*
+* Arguments  : none
+*
+* Returns    : none
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*********************************************************************************************************
+*/
+
+void  OS_LiteInit (void)
+{
+    OS_MemClr((INT8U *)&OSLiteDispTbl[0], sizeof(OSLiteDispTbl));
+}
+
+
+/*
+*********************************************************************************************************
+*                                          LITE TASK DISPATCHER
+*
+* Description: This task runs the lite tasks created at its priority.  It calls them over and over as long
+*              as one of them makes progress, then sleeps for one tick (or until the nearest delay
+*              expires, or until a lite task is created) before polling them again.
+*
+* Arguments  : p_arg     is a pointer to the dispatcher (OS_LITE_DISP).
+*
+* Returns    : none
+*********************************************************************************************************
+*/
+
+static  void  OS_LiteTask (void  *p_arg)
+{
+    OS_LITE_DISP  *pdisp;
+    OS_LITE       *plite;
+    OS_LITE       *pnext;
+    OS_LITE      **pplite;
+    INT16U         lc;
+    INT8U          ret;
+    BOOLEAN        run;
+    INT32U         sleep;
+    INT32U         left;
+#if OS_CRITICAL_METHOD == 3u                     /* Allocate storage for CPU status register           */
+    OS_CPU_SR      cpu_sr = 0u;
+#endif
+
+
+    pdisp = (OS_LITE_DISP *)p_arg;
+    for (;;) {
+        run   = OS_FALSE;
+        sleep = (INT32U)RT_WAITING_FOREVER;
+        OS_ENTER_CRITICAL();
+        plite = pdisp->OSLiteDispList;
+        OS_EXIT_CRITICAL();
+        while (plite != (OS_LITE *)0) {
+            lc               = plite->OSLiteLc;
+            plite->OSLiteRdy = OS_FALSE;
+            ret              = (*plite->OSLiteFnct)(plite);
+            OS_ENTER_CRITICAL();
+            pnext            = plite->OSLiteNext;
+            if (ret == OS_LITE_ENDED) {          /* Remove the lite task from the list                 */
+                pplite = &pdisp->OSLiteDispList;
+                while (*pplite != plite) {
+                    pplite = &(*pplite)->OSLiteNext;
+                }
+                *pplite = pnext;
+            }
+            OS_EXIT_CRITICAL();
+            if ((ret == OS_LITE_ENDED) || (plite->OSLiteRdy == OS_TRUE) || (plite->OSLiteLc != lc)) {
+                run = OS_TRUE;                   /* Lite task made progress, run them all again        */
+            } else if (plite->OSLiteEventPtr != (void *)0) {
+                sleep = 1u;                      /* Poll the object on the next tick                   */
+            } else {
+                left = (INT32U)(rt_tick_get() - plite->OSLiteTickStart);
+                if (left < plite->OSLiteTicks) { /* Ticks left before the delay expires                */
+                    left = plite->OSLiteTicks - left;
+                } else {
+                    left = 1u;
+                }
+                if ((sleep == (INT32U)RT_WAITING_FOREVER) || (left < sleep)) {
+                    sleep = left;                /* Wake up for the nearest delay                      */
+                }
+            }
+            plite = pnext;
+        }
+        if (run == OS_FALSE) {
+            rt_sem_take(&pdisp->OSLiteDispSem, (rt_int32_t)sleep);
+        }
+    }
+}
+
+#endif
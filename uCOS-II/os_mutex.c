@@ -541,6 +541,9 @@ INT8U  OSMutexQuery (OS_EVENT       *pevent,
                      OS_MUTEX_DATA  *p_mutex_data)
 {
     rt_mutex_t pmutex;
+#if OS_PRIO_MAP_EN > 0u
+    OS_TCB     *ptcb;
+#endif
 #if OS_CRITICAL_METHOD == 3u                     /* Allocate storage for CPU status register           */
     OS_CPU_SR   cpu_sr = 0u;
 #endif
@@ -566,7 +569,16 @@ INT8U  OSMutexQuery (OS_EVENT       *pevent,
 
     OS_ENTER_CRITICAL();
     rt_memcpy(&p_mutex_data->OSMutex, pmutex, sizeof(struct rt_mutex));
+#if OS_PRIO_MAP_EN > 0u
+    ptcb = OS_TCBFromThread(pmutex->owner);                /* Report uC/OS-II priority of a uC/OS task */
+    if (ptcb != (OS_TCB *)0) {
+        p_mutex_data->OSOwnerPrio = ptcb->OSTCBPrio;
+    } else {
+        p_mutex_data->OSOwnerPrio = pmutex->owner->current_priority;
+    }
+#else
     p_mutex_data->OSOwnerPrio = pmutex->owner->current_priority;
+#endif
     OS_EXIT_CRITICAL();
     return (OS_ERR_NONE);
 }
@@ -0,0 +1,264 @@
+/*
+ * Copyright (c) 2021, Meco Jianting Man <jiantingman@foxmail.com>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+/*
+*********************************************************************************************************
+*                                              uC/OS-II
+*                                        The Real-Time Kernel
+*
+*                    Copyright 1992-2020 Silicon Laboratories Inc. www.silabs.com
+*
+*                                 SPDX-License-Identifier: APACHE-2.0
+*
+*               This software is subject to an open source license and is distributed by
+*                Silicon Laboratories Inc. pursuant to the terms of the Apache License,
+*                    Version 2.0 available at www.apache.org/licenses/LICENSE-2.0.
+*
+*********************************************************************************************************
+*/
+
+
+/*
+*********************************************************************************************************
+*
+*                                          TASK POOL MANAGEMENT
+*
+* Filename : os_pool.c
+* Version  : V2.93.00
+*********************************************************************************************************
+* Note(s)  : 1) A task pool is a set of worker tasks created once by OSTaskPoolCreate() and parked on a
+*               semaphore.  OSTaskPoolRun() queues a job and releases the semaphore; a parked worker
+*               takes the job, runs it and parks again.  Running a job thus reuses the TCB and the stack
+*               of a worker instead of paying for OSTaskCreateExt() and OSTaskDel() (TCB allocation,
+*               stack painting, thread detach and cleanup in the idle thread).
+*
+*            2) A job must return to give its worker back to the pool.  A job must not delete its
+*               worker.
+*********************************************************************************************************
+*/
+
+#include "ucos_ii.h"
+
+#if OS_TASK_POOL_EN > 0u
+
+/*
+*********************************************************************************************************
+*                                          LOCAL PROTOTYPES
+*********************************************************************************************************
+*/
+
+static  void  OS_TaskPoolWorker (void  *p_arg);
+
+
+/*
+*********************************************************************************************************
+*                                           CREATE A TASK POOL
+*
+* Description: This function creates the worker tasks of a task pool.  The workers run at priorities
+*              'prio' to 'prio + nbr - 1' and wait for jobs submitted with OSTaskPoolRun().
+*
+* Arguments  : ppool     is a pointer to the task pool to create.
+*
+*              prio      is the priority of the first worker.  The 'nbr' priorities from 'prio' must be
+*                        free.
+*
+*              nbr       is the number of workers.
+*
+*              pstk      is a pointer to the stacks of the workers, an array of 'nbr * stk_size' OS_STK
+*                        elements which is split evenly between the workers.
+*
+*              stk_size  is the stack size of each worker (in number of OS_STK elements).
+*
+*              pjob      is a pointer to an array of 'job_size' entries holding the jobs not yet taken by
+*                        a worker.
+*
+*              job_size  is the number of entries in 'pjob'.
+*
+* Returns    : OS_ERR_NONE              if the task pool was created.
+*              OS_ERR_PDATA_NULL        if 'ppool', 'pstk' or 'pjob' is a NULL pointer.
+*              OS_ERR_PRIO_INVALID      if 'nbr' is 0 or a worker priority is >= OS_LOWEST_PRIO.
+*              OS_ERR_TASK_CREATE_ISR   if you tried to create a task pool from an ISR.
+*              Any error returned by OSTaskCreateExt(), in which case the workers already created are
+*              deleted.
+*********************************************************************************************************
+*/
+
+INT8U  OSTaskPoolCreate (OS_TASK_POOL      *ppool,
+                         INT8U              prio,
+                         INT8U              nbr,
+                         OS_STK            *pstk,
+                         INT32U             stk_size,
+                         OS_TASK_POOL_JOB  *pjob,
+                         INT16U             job_size)
+{
+    INT8U    i;
+    INT8U    err;
+    OS_STK  *pbos;
+
+
+#if OS_ARG_CHK_EN > 0u
+    if (ppool == (OS_TASK_POOL *)0) {            /* Validate arguments                                 */
+        return (OS_ERR_PDATA_NULL);
+    }
+    if (pstk == (OS_STK *)0) {
+        return (OS_ERR_PDATA_NULL);
+    }
+    if ((pjob == (OS_TASK_POOL_JOB *)0) || (job_size == 0u)) {
+        return (OS_ERR_PDATA_NULL);
+    }
+    if ((nbr == 0u) || ((INT16U)prio + (INT16U)nbr > (INT16U)OS_LOWEST_PRIO)) {
+        return (OS_ERR_PRIO_INVALID);
+    }
+#endif
+    if (OSIntNesting > 0u) {                     /* Make sure we don't create from within an ISR       */
+        return (OS_ERR_TASK_CREATE_ISR);
+    }
+    ppool->OSPoolJobTbl  = pjob;
+    ppool->OSPoolJobSize = job_size;
+    ppool->OSPoolJobIn   = 0u;
+    ppool->OSPoolJobOut  = 0u;
+    ppool->OSPoolJobCnt  = 0u;
+    ppool->OSPoolPrio    = prio;
+    ppool->OSPoolNbr     = nbr;
+    rt_sem_init(&ppool->OSPoolSem, "uCPool", 0u, RT_IPC_FLAG_FIFO);
+
+    for (i = 0u; i < nbr; i++) {
+        pbos = pstk + (INT32U)i * stk_size;      /* Each worker gets its own slice of 'pstk'           */
+#if OS_STK_GROWTH == 1u
+        err  = OSTaskCreateExt(OS_TaskPoolWorker,
+                               (void *)ppool,
+                               pbos + stk_size - 1u,                           /* Set Top-Of-Stack           */
+                               (INT8U)(prio + i),
+                               (INT16U)(prio + i),
+                               pbos,                                           /* Set Bottom-Of-Stack        */
+                               stk_size,
+                               (void *)0,
+                               OS_TASK_OPT_STK_CHK | OS_TASK_OPT_STK_CLR);
+#else
+        err  = OSTaskCreateExt(OS_TaskPoolWorker,
+                               (void *)ppool,
+                               pbos,                                           /* Set Top-Of-Stack           */
+                               (INT8U)(prio + i),
+                               (INT16U)(prio + i),
+                               pbos + stk_size - 1u,                           /* Set Bottom-Of-Stack        */
+                               stk_size,
+                               (void *)0,
+                               OS_TASK_OPT_STK_CHK | OS_TASK_OPT_STK_CLR);
+#endif
+        if (err != OS_ERR_NONE) {
+#if OS_TASK_DEL_EN > 0u
+            while (i > 0u) {                     /* Undo the workers already created                   */
+                i--;
+                (void)OSTaskDel((INT8U)(prio + i));
+            }
+#endif
+            rt_sem_detach(&ppool->OSPoolSem);
+            return (err);
+        }
+#if OS_TASK_NAME_EN > 0u
+        OSTaskNameSet((INT8U)(prio + i), (INT8U *)(void *)"uC/OS-II Pool", &err);
+#endif
+    }
+    return (OS_ERR_NONE);
+}
+
+
+/*
+*********************************************************************************************************
+*                                        RUN A JOB IN A TASK POOL
+*
+* Description: This function submits a job to a task pool.  The job is run by the first worker to wait for
+*              a job, or queued until a worker becomes available.
+*
+* Arguments  : ppool     is a pointer to the task pool.
+*
+*              fnct      is the job function.
+*
+*              p_arg     is the argument passed to 'fnct'.
+*
+* Returns    : OS_ERR_NONE              if the job was queued.
+*              OS_ERR_PDATA_NULL        if 'ppool' or 'fnct' is a NULL pointer.
+*              OS_ERR_TASK_POOL_FULL    if 'job_size' jobs are already waiting for a worker.
+*
+* Note(s)    : 1) This function can be called from an ISR.
+*********************************************************************************************************
+*/
+
+INT8U  OSTaskPoolRun (OS_TASK_POOL       *ppool,
+                      OS_TASK_POOL_FNCT   fnct,
+                      void               *p_arg)
+{
+    OS_TASK_POOL_JOB  *pjob;
+#if OS_CRITICAL_METHOD == 3u                     /* Allocate storage for CPU status register           */
+    OS_CPU_SR          cpu_sr = 0u;
+#endif
+
+
+#if OS_ARG_CHK_EN > 0u
+    if (ppool == (OS_TASK_POOL *)0) {            /* Validate arguments                                 */
+        return (OS_ERR_PDATA_NULL);
+    }
+    if (fnct == (OS_TASK_POOL_FNCT)0) {
+        return (OS_ERR_PDATA_NULL);
+    }
+#endif
+    OS_ENTER_CRITICAL();
+    if (ppool->OSPoolJobCnt >= ppool->OSPoolJobSize) {
+        OS_EXIT_CRITICAL();
+        return (OS_ERR_TASK_POOL_FULL);
+    }
+    pjob             = &ppool->OSPoolJobTbl[ppool->OSPoolJobIn];
+    pjob->OSJobFnct  = fnct;
+    pjob->OSJobArg   = p_arg;
+    ppool->OSPoolJobIn++;
+    if (ppool->OSPoolJobIn == ppool->OSPoolJobSize) {
+        ppool->OSPoolJobIn = 0u;
+    }
+    ppool->OSPoolJobCnt++;
+    OS_EXIT_CRITICAL();
+    rt_sem_release(&ppool->OSPoolSem);           /* Wake up a parked worker                            */
+    return (OS_ERR_NONE);
+}
+
+
+/*
+*********************************************************************************************************
+*                                           TASK POOL WORKER
+*
+* Description: This task waits for the jobs submitted to its task pool and runs them.
+*
+* Arguments  : p_arg     is a pointer to the task pool.
+*
+* Returns    : none
+*********************************************************************************************************
+*/
+
+static  void  OS_TaskPoolWorker (void  *p_arg)
+{
+    OS_TASK_POOL       *ppool;
+    OS_TASK_POOL_FNCT   fnct;
+    void               *arg;
+#if OS_CRITICAL_METHOD == 3u                     /* Allocate storage for CPU status register           */
+    OS_CPU_SR           cpu_sr = 0u;
+#endif
+
+
+    ppool = (OS_TASK_POOL *)p_arg;
+    for (;;) {
+        rt_sem_take(&ppool->OSPoolSem, RT_WAITING_FOREVER);      /* Park until a job is queued         */
+        OS_ENTER_CRITICAL();
+        fnct = ppool->OSPoolJobTbl[ppool->OSPoolJobOut].OSJobFnct;
+        arg  = ppool->OSPoolJobTbl[ppool->OSPoolJobOut].OSJobArg;
+        ppool->OSPoolJobOut++;
+        if (ppool->OSPoolJobOut == ppool->OSPoolJobSize) {
+            ppool->OSPoolJobOut = 0u;
+        }
+        ppool->OSPoolJobCnt--;
+        OS_EXIT_CRITICAL();
+        (*fnct)(arg);                                            /* Run the job                        */
+    }
+}
+
+#endif
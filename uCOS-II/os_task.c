@@ -36,6 +36,230 @@
 
 #include "ucos_ii.h"
 
+/*
+*********************************************************************************************************
+*                                           LOCAL DATA TYPES
+*********************************************************************************************************
+*/
+
+#if (OS_TASK_CREATE_EN > 0u) && (OS_TASK_STK_REG_MAX > 0u)
+typedef struct os_stk_reg {                 /* Stack registered with OSTaskStkRegister()               */
+    OS_STK          *OSStkRegBase;          /* Lowest memory location of the stack                     */
+    INT32U           OSStkRegSize;          /* Size of the stack (in number of stack elements)         */
+} OS_STK_REG;
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                           LOCAL VARIABLES
+*********************************************************************************************************
+*/
+
+#if (OS_TASK_CREATE_EN > 0u) && (OS_TASK_STK_REG_MAX > 0u)
+static  OS_STK_REG  OSTaskStkRegTbl[OS_TASK_STK_REG_MAX];  /* Stacks known to OSTaskCreate()           */
+static  INT8U       OSTaskStkRegCtr;                       /* Number of entries used in the table      */
+#endif
+
+#if OS_TASK_BUDGET_EN > 0u
+static  struct rt_timer  OSTaskBudgetTmr;                  /* Charges and replenishes the CPU budgets  */
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                          LOCAL PROTOTYPES
+*********************************************************************************************************
+*/
+
+static  INT8U  OS_TaskCreate   (void   (*task)(void *p_arg),
+                                void    *p_arg,
+                                OS_STK  *ptos,
+                                INT8U    prio,
+                                INT16U   id,
+                                OS_STK  *pbos,
+                                INT32U   stk_size,
+                                void    *pext,
+                                INT16U   opt,
+                                INT32U   time_slice);
+
+static  void   OS_TaskStart    (OS_TCB      *ptcb,
+                                void       (*task)(void *p_arg),
+                                void        *p_arg,
+                                OS_STK      *pstk_base,
+                                INT32U       stk_size,
+                                INT32U       time_slice,
+                                const char  *name);
+
+#if OS_TASK_CREATE_EN > 0u
+static  INT8U  OS_TaskStkFind  (OS_STK  *ptos,
+                                OS_STK **ppbos,
+                                INT32U  *pstk_size);
+#endif
+
+#if OS_TASK_BUDGET_EN > 0u
+static  void   OS_TaskBudgetTick (void  *parameter);
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                     SET THE CPU AFFINITY OF A TASK
+*
+* Description: This function is called to restrict the cores on which a task may run (RT-Thread SMP).
+*
+* Arguments  : prio        is the priority of the task.  You can specify OS_PRIO_SELF.
+*
+*              cpu_mask    is a bit mask of the allowed cores, bit 'n' standing for core 'n'.  0 or a mask
+*                          holding all the cores lets the task run on any core.
+*
+* Returns    : OS_ERR_NONE              if the affinity was changed.
+*              OS_ERR_PRIO_INVALID      if the priority you specify is higher that the maximum allowed
+*                                       (i.e. >= OS_LOWEST_PRIO) or, you have not specified OS_PRIO_SELF.
+*              OS_ERR_TASK_CPU_INVALID  if 'cpu_mask' names a core that does not exist or more than one
+*                                       core but not all of them.
+*              OS_ERR_TASK_NOT_EXIST    if the task does not exist or is assigned to a Mutex PIP.
+*
+* Note(s)    : 1) RT-Thread binds a thread to a single core, so a mask is either one core or all of them.
+*              2) A task which is running on another core is migrated at its next context switch.
+*********************************************************************************************************
+*/
+
+#if OS_TASK_AFFINITY_EN > 0u
+INT8U  OSTaskAffinitySet (INT8U   prio,
+                          INT32U  cpu_mask)
+{
+    OS_TCB     *ptcb;
+    rt_ubase_t  cpu;
+#if OS_CRITICAL_METHOD == 3u                     /* Allocate storage for CPU status register           */
+    OS_CPU_SR   cpu_sr = 0u;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0u
+    if (prio >= OS_LOWEST_PRIO) {                /* Task priority valid ?                              */
+        if (prio != OS_PRIO_SELF) {
+            return (OS_ERR_PRIO_INVALID);
+        }
+    }
+#endif
+    if ((RT_CPUS_NR < 32) && ((cpu_mask >> RT_CPUS_NR) != 0uL)) {
+        return (OS_ERR_TASK_CPU_INVALID);        /* Mask names a core that does not exist              */
+    }
+    if ((cpu_mask == 0uL) || (cpu_mask == (INT32U)((1uLL << RT_CPUS_NR) - 1uLL))) {
+        cpu = RT_CPUS_NR;                        /* RT_CPUS_NR means 'any core' to RT-Thread           */
+    } else if ((cpu_mask & (cpu_mask - 1uL)) == 0uL) {
+        cpu = 0u;                                /* Single core, find its number                       */
+        while ((cpu_mask & 1uL) == 0uL) {
+            cpu_mask >>= 1u;
+            cpu++;
+        }
+    } else {
+        return (OS_ERR_TASK_CPU_INVALID);        /* Sets of cores are not supported by RT-Thread       */
+    }
+    OS_ENTER_CRITICAL();
+    if (prio == OS_PRIO_SELF) {                  /* See if changing SELF                               */
+        prio = OSTCBCur->OSTCBPrio;
+    }
+    ptcb = OSTCBPrioTbl[prio];
+    if ((ptcb == (OS_TCB *)0) || (ptcb == OS_TCB_RESERVED)) {
+        OS_EXIT_CRITICAL();
+        return (OS_ERR_TASK_NOT_EXIST);
+    }
+    OS_EXIT_CRITICAL();
+    rt_thread_control(&ptcb->OSTask, RT_THREAD_CTRL_BIND_CPU, (void *)cpu);
+    return (OS_ERR_NONE);
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                        SET THE CPU BUDGET OF A TASK
+*
+* Description: This function is called to limit the CPU time a task may consume.  A task that has run for
+*              'budget_ticks' ticks within a replenishment period is suspended (throttled) until the period
+*              ends, leaving the remaining CPU time to lower priority tasks.
+*
+* Arguments  : prio          is the priority of the task.  You can specify OS_PRIO_SELF.
+*
+*              budget_ticks  is the number of ticks the task may run per period.  0 removes the budget and
+*                            releases the task if it is currently throttled.
+*
+*              period_ticks  is the replenishment period (in ticks), it must not be less than 'budget_ticks'.
+*
+* Returns    : OS_ERR_NONE                 if the budget was changed.
+*              OS_ERR_PRIO_INVALID         if the priority you specify is higher that the maximum allowed
+*                                          (i.e. >= OS_LOWEST_PRIO) or, you have not specified OS_PRIO_SELF.
+*              OS_ERR_TASK_BUDGET_INVALID  if 'period_ticks' is less than 'budget_ticks'.
+*              OS_ERR_TASK_NOT_EXIST       if the task does not exist or is assigned to a Mutex PIP.
+*
+* Note(s)    : 1) The budget is charged one tick at a time to the task that was interrupted by the tick.
+*              2) A new budget and period both start from the time of the call.
+*              3) A throttled task still holds the mutexes it owns, don't put a budget on a task that holds
+*                 a mutex needed by a more important task for longer than its budget.
+*********************************************************************************************************
+*/
+
+#if OS_TASK_BUDGET_EN > 0u
+INT8U  OSTaskBudgetSet (INT8U   prio,
+                        INT32U  budget_ticks,
+                        INT32U  period_ticks)
+{
+    OS_TCB    *ptcb;
+    BOOLEAN    release;
+#if OS_CRITICAL_METHOD == 3u                     /* Allocate storage for CPU status register           */
+    OS_CPU_SR  cpu_sr = 0u;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0u
+    if (prio >= OS_LOWEST_PRIO) {                /* Task priority valid ?                              */
+        if (prio != OS_PRIO_SELF) {
+            return (OS_ERR_PRIO_INVALID);
+        }
+    }
+#endif
+    if ((budget_ticks > 0u) && (period_ticks < budget_ticks)) {
+        return (OS_ERR_TASK_BUDGET_INVALID);
+    }
+    OS_ENTER_CRITICAL();
+    if (prio == OS_PRIO_SELF) {                  /* See if changing SELF                               */
+        prio = OSTCBCur->OSTCBPrio;
+    }
+    ptcb = OSTCBPrioTbl[prio];
+    if ((ptcb == (OS_TCB *)0) || (ptcb == OS_TCB_RESERVED)) {
+        OS_EXIT_CRITICAL();
+        return (OS_ERR_TASK_NOT_EXIST);
+    }
+    ptcb->OSTCBBudget           = budget_ticks;
+    ptcb->OSTCBBudgetLeft       = budget_ticks;
+    ptcb->OSTCBBudgetPeriod     = period_ticks;
+    ptcb->OSTCBBudgetPeriodLeft = period_ticks;
+    release = OS_FALSE;
+    if (ptcb->OSTCBBudgetThrottled == OS_TRUE) { /* Budget was changed, start afresh                   */
+        ptcb->OSTCBBudgetThrottled = OS_FALSE;
+        if ((ptcb->OSTCBStat & OS_STAT_SUSPEND) == OS_STAT_RDY) {
+            release = OS_TRUE;                   /* Not also suspended by OSTaskSuspend()              */
+        }
+    }
+    if ((budget_ticks > 0u) &&
+        !(OSTaskBudgetTmr.parent.flag & RT_TIMER_FLAG_ACTIVATED)) {
+        rt_timer_start(&OSTaskBudgetTmr);        /* Start charging ticks with the first budget         */
+    }
+    OS_EXIT_CRITICAL();
+    if (release == OS_TRUE) {
+        rt_thread_resume(&ptcb->OSTask);
+        if (OSRunning == OS_TRUE) {
+            OS_Sched();
+        }
+    }
+    return (OS_ERR_NONE);
+}
+#endif
+
 
 /*
 *********************************************************************************************************
@@ -62,9 +286,10 @@
 INT8U  OSTaskChangePrio (INT8U  oldprio,
                          INT8U  newprio)
 {
-    OS_TCB    *ptcb;
+    OS_TCB     *ptcb;
+    rt_uint8_t  rt_prio;
 #if OS_CRITICAL_METHOD == 3u
-    OS_CPU_SR  cpu_sr = 0u;                                 /* Storage for CPU status register         */
+    OS_CPU_SR   cpu_sr = 0u;                                /* Storage for CPU status register         */
 #endif
 
 
@@ -102,7 +327,8 @@ INT8U  OSTaskChangePrio (INT8U  oldprio,
     ptcb->OSTCBPrio = newprio;                              /* Set new task priority                   */
     OS_EXIT_CRITICAL();
 
-    rt_thread_control(&(ptcb->OSTask), RT_THREAD_CTRL_CHANGE_PRIORITY, &newprio);
+    rt_prio = OS_PRIO_TO_RT(newprio);
+    rt_thread_control(&(ptcb->OSTask), RT_THREAD_CTRL_CHANGE_PRIORITY, &rt_prio);
 
     if (OSRunning == OS_TRUE) {
         OS_Sched();                                         /* Find new highest priority task          */
@@ -151,6 +377,19 @@ INT8U  OSTaskChangePrio (INT8U  oldprio,
 *              OS_ERR_TASK_CREATE_ISR          if you tried to create a task from an ISR.
 *              OS_ERR_ILLEGAL_CREATE_RUN_TIME  if you tried to create a task after safety critical
 *                                              operation started.
+*              OS_ERR_TASK_STK_NOT_REG         if 'ptos' is not inside a stack registered with
+*                                              OSTaskStkRegister() and OS_TASK_CREATE_STK_SIZE is 0.
+*
+* Note(s)    : 1) RT-Thread needs to know the extent of the stack.  If 'ptos' lies inside a stack that was
+*                 registered with OSTaskStkRegister(), the stack runs from 'ptos' to the end of that
+*                 stack.  Otherwise the task is only created if OS_TASK_CREATE_STK_SIZE is not 0, in
+*                 which case the stack is assumed to be OS_TASK_CREATE_STK_SIZE entries large.
+*
+*                 WARNING: RT-Thread fills the whole assumed extent when it initializes the task.  A
+*                          stack smaller than OS_TASK_CREATE_STK_SIZE entries is overrun and the memory
+*                          next to it is corrupted.  Register every stack, or use OSTaskCreateExt().
+*              2) The lookup is only done here, nothing is allocated and the task switch path is not
+*                 affected.
 *********************************************************************************************************
 */
 
@@ -160,10 +399,102 @@ INT8U  OSTaskCreate (void   (*task)(void *p_arg),
                      OS_STK  *ptos,
                      INT8U    prio)
 {
-    /*TODO*/
-    return OS_ERR_TASK_NO_MORE_TCB;
+    OS_STK     *pbos;
+    INT32U      stk_size;
+    INT8U       err;
+
+
+#ifdef OS_SAFETY_CRITICAL_IEC61508
+    if (OSSafetyCriticalStartFlag == OS_TRUE) {
+        OS_SAFETY_CRITICAL_EXCEPTION();
+        return (OS_ERR_ILLEGAL_CREATE_RUN_TIME);
+    }
+#endif
+
+#if OS_ARG_CHK_EN > 0u
+    if (prio > OS_LOWEST_PRIO) {             /* Make sure priority is within allowable range           */
+        return (OS_ERR_PRIO_INVALID);
+    }
+#endif
+    err = OS_TaskStkFind(ptos, &pbos, &stk_size); /* Find out how large the stack is                   */
+    if (err != OS_ERR_NONE) {
+        return (err);
+    }
+    return (OS_TaskCreate(task,
+                          p_arg,
+                          ptos,
+                          prio,
+                          0u,
+                          pbos,
+                          stk_size,
+                          (void *)0,
+                          OS_TASK_OPT_NONE,
+                          OS_TASK_TIME_SLICE_DFLT));
+}
+
+
+/*
+*********************************************************************************************************
+*                                        REGISTER A TASK STACK
+*
+* Description: This function tells OSTaskCreate() the extent of a stack so that tasks created with
+*              OSTaskCreate() on this stack get the right size.  Unless OS_TASK_CREATE_STK_SIZE is set,
+*              OSTaskCreate() refuses stacks that are not registered.
+*
+* Arguments  : pstk      is a pointer to the LOWEST memory location of the stack (i.e. &stk[0]).
+*
+*              stk_size  is the size of the stack in number of elements.
+*
+* Returns    : OS_ERR_NONE               if the stack was registered.
+*              OS_ERR_PDATA_NULL         if 'pstk' is a NULL pointer or 'stk_size' is 0.
+*              OS_ERR_TASK_STK_REG_FULL  if OS_TASK_STK_REG_MAX stacks are already registered.
+*
+* Note(s)    : 1) Typically called once per stack before OSTaskCreate(), e.g.:
+*
+*                     static OS_STK  MyTaskStk[512];
+*
+*                     OSTaskStkRegister(&MyTaskStk[0], 512);
+*                     OSTaskCreate(MyTask, (void *)0, &MyTaskStk[511], 5);
+*
+*              2) Registering the same stack again updates its size.
+*********************************************************************************************************
+*/
+
+#if OS_TASK_STK_REG_MAX > 0u
+INT8U  OSTaskStkRegister (OS_STK  *pstk,
+                          INT32U   stk_size)
+{
+    INT8U       i;
+#if OS_CRITICAL_METHOD == 3u                 /* Allocate storage for CPU status register               */
+    OS_CPU_SR   cpu_sr = 0u;
+#endif
+
+
+#if OS_ARG_CHK_EN > 0u
+    if ((pstk == (OS_STK *)0) || (stk_size == 0u)) {
+        return (OS_ERR_PDATA_NULL);
+    }
+#endif
+    OS_ENTER_CRITICAL();
+    for (i = 0u; i < OSTaskStkRegCtr; i++) { /* See if stack is already registered                     */
+        if (OSTaskStkRegTbl[i].OSStkRegBase == pstk) {
+            OSTaskStkRegTbl[i].OSStkRegSize = stk_size;
+            OS_EXIT_CRITICAL();
+            return (OS_ERR_NONE);
+        }
+    }
+    if (OSTaskStkRegCtr >= OS_TASK_STK_REG_MAX) {
+        OS_EXIT_CRITICAL();
+        return (OS_ERR_TASK_STK_REG_FULL);
+    }
+    OSTaskStkRegTbl[OSTaskStkRegCtr].OSStkRegBase = pstk;
+    OSTaskStkRegTbl[OSTaskStkRegCtr].OSStkRegSize = stk_size;
+    OSTaskStkRegCtr++;
+    OS_EXIT_CRITICAL();
+    return (OS_ERR_NONE);
 }
 #endif
+#endif
 
 
 /*
@@ -223,7 +554,8 @@ INT8U  OSTaskCreate (void   (*task)(void *p_arg),
 *                        specific.  See OS_TASK_OPT_??? in uCOS-II.H.  Current choices are:
 *
 *                        OS_TASK_OPT_STK_CHK      Stack checking to be allowed for the task
-*                        OS_TASK_OPT_STK_CLR      Clear the stack when the task is created
+*                        OS_TASK_OPT_STK_CLR      Clear the stack when the task is created (RT-Thread
+*                                                 always fills the whole stack, this option is implied)
 *                        OS_TASK_OPT_SAVE_FP      If the CPU has floating-point registers, save them
 *                                                 during a context switch.
 *
@@ -249,15 +581,53 @@ INT8U  OSTaskCreateExt (void   (*task)(void *p_arg),
                         void    *pext,
                         INT16U   opt)
 {
-    INT8U       err;
-    OS_TCB     *ptcb;
-    OS_STK     *convert;
-    char        name[RT_NAME_MAX];
-#if OS_CRITICAL_METHOD == 3u                 /* Allocate storage for CPU status register               */
-    OS_CPU_SR   cpu_sr = 0u;
+#ifdef OS_SAFETY_CRITICAL_IEC61508
+    if (OSSafetyCriticalStartFlag == OS_TRUE) {
+        OS_SAFETY_CRITICAL_EXCEPTION();
+        return (OS_ERR_ILLEGAL_CREATE_RUN_TIME);
+    }
+#endif
+
+#if OS_ARG_CHK_EN > 0u
+    if (prio > OS_LOWEST_PRIO) {             /* Make sure priority is within allowable range           */
+        return (OS_ERR_PRIO_INVALID);
+    }
 #endif
+    return (OS_TaskCreate(task, p_arg, ptos, prio, id, pbos, stk_size, pext, opt, OS_TASK_TIME_SLICE_DFLT));
+}
+
 
+/*
+*********************************************************************************************************
+*                             CREATE A TASK (Extended Version with time slice)
+*
+* Description: This function is identical to OSTaskCreateExt() except that it also sets the round-robin
+*              time slice of the task.
+*
+* Arguments  : task .. opt  see OSTaskCreateExt().
+*
+*              time_slice   is the number of ticks the task may run before RT-Thread hands the CPU to the
+*                           next ready thread of the same priority.  0 selects OS_TASK_TIME_SLICE_DFLT.
+*
+* Returns    : see OSTaskCreateExt().
+*
+* Note(s)    : 1) uC/OS-II tasks have unique priorities, the time slice thus only matters with respect to
+*                 native RT-Thread threads running at the same priority.
+*********************************************************************************************************
+*/
 
+#if OS_TASK_TIME_SLICE_EN > 0u
+INT8U  OSTaskCreateExt2 (void   (*task)(void *p_arg),
+                         void    *p_arg,
+                         OS_STK  *ptos,
+                         INT8U    prio,
+                         INT16U   id,
+                         OS_STK  *pbos,
+                         INT32U   stk_size,
+                         void    *pext,
+                         INT16U   opt,
+                         INT32U   time_slice)
+{
 #ifdef OS_SAFETY_CRITICAL_IEC61508
     if (OSSafetyCriticalStartFlag == OS_TRUE) {
         OS_SAFETY_CRITICAL_EXCEPTION();
@@ -270,38 +640,154 @@ INT8U  OSTaskCreateExt (void   (*task)(void *p_arg),
         return (OS_ERR_PRIO_INVALID);
     }
 #endif
+    return (OS_TaskCreate(task, p_arg, ptos, prio, id, pbos, stk_size, pext, opt, time_slice));
+}
+#endif
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                  CREATE TASKS FROM A CONFIGURATION TABLE
+*
+* Description: This function creates all the tasks described by a (typically const, flash resident) table
+*              of OS_TASK_CFG entries.  The table is validated as a whole before any task is created, and
+*              the scheduler is locked while the tasks are created: the caller is only preempted once,
+*              when the highest priority of the new tasks runs.
+*
+* Arguments  : ptbl      is a pointer to the table.  For each entry:
+*
+*                        OSTaskCfgFnct     is the task's code.
+*                        OSTaskCfgArg      is the argument passed to the task.
+*                        OSTaskCfgStk      is the LOWEST memory location of the task's stack, whatever
+*                                          OS_STK_GROWTH is.
+*                        OSTaskCfgStkSize  is the size of the stack in number of OS_STK elements.
+*                        OSTaskCfgPrio     is the task's priority.
+*                        OSTaskCfgId       is the task's ID.
+*                        OSTaskCfgName     is the task's name, or a NULL pointer to use the default name.
+*                        OSTaskCfgOpt      contains the options of the task, see OSTaskCreateExt().
+*
+*              nbr       is the number of entries in the table.
+*
+* Returns    : OS_ERR_NONE                     if all the tasks were created.
+*              OS_ERR_PDATA_NULL               if 'ptbl' is a NULL pointer, 'nbr' is 0 or, an entry has no
+*                                              task code or no stack.
+*              OS_ERR_PRIO_INVALID             if the priority of an entry is >= OS_LOWEST_PRIO.
+*              OS_ERR_PRIO_EXIST               if the priority of an entry is already taken, by an existing
+*                                              task or by an other entry of the table.
+*              OS_ERR_TASK_NO_MORE_TCB         if there are less than 'nbr' free OS_TCBs.
+*              OS_ERR_TASK_CREATE_ISR          if you tried to create the tasks from an ISR.
+*            - OS_ERR_ILLEGAL_CREATE_RUN_TIME  if you tried to create the tasks after safety critical
+*                                              operation started.
+*
+* Note(s)    : 1) No task is created unless OS_ERR_NONE is returned.
+*              2) The name is also copied into the RT-Thread thread (truncated to RT_NAME_MAX).  The TCB
+*                 only keeps a pointer to it, the name MUST thus remain valid as long as the task exists.
+*********************************************************************************************************
+*/
+
+#if OS_TASK_CREATE_TBL_EN > 0u
+INT8U  OSTaskCreateTable (const OS_TASK_CFG  *ptbl,
+                          INT8U               nbr)
+{
+    INT8U               i;
+    INT8U               j;
+    INT8U               err;
+    OS_TCB             *ptcb;
+    const OS_TASK_CFG  *pcfg;
+    OS_STK             *ptos;
+    OS_STK             *pbos;
+    char                name[RT_NAME_MAX];
+#if OS_CRITICAL_METHOD == 3u                 /* Allocate storage for CPU status register               */
+    OS_CPU_SR           cpu_sr = 0u;
+#endif
+
+
+
+#ifdef OS_SAFETY_CRITICAL_IEC61508
+    if (OSSafetyCriticalStartFlag == OS_TRUE) {
+        OS_SAFETY_CRITICAL_EXCEPTION();
+        return (OS_ERR_ILLEGAL_CREATE_RUN_TIME);
+    }
+#endif
+
+#if OS_ARG_CHK_EN > 0u
+    if ((ptbl == (const OS_TASK_CFG *)0) || (nbr == 0u)) {
+        return (OS_ERR_PDATA_NULL);
+    }
+    for (i = 0u; i < nbr; i++) {             /* Validate the whole table first                         */
+        pcfg = &ptbl[i];
+        if ((pcfg->OSTaskCfgFnct == (void (*)(void *))0) ||
+            (pcfg->OSTaskCfgStk  == (OS_STK *)0)         ||
+            (pcfg->OSTaskCfgStkSize == 0u)) {
+            return (OS_ERR_PDATA_NULL);
+        }
+        if (pcfg->OSTaskCfgPrio >= OS_LOWEST_PRIO) {
+            return (OS_ERR_PRIO_INVALID);
+        }
+    }
+#endif
+    if (OSIntNesting > 0u) {                 /* Make sure we don't create the tasks from an ISR        */
+        return (OS_ERR_TASK_CREATE_ISR);
+    }
+
+    rt_enter_critical();                     /* One scheduling point for the whole table               */
     OS_ENTER_CRITICAL();
-    if (OSIntNesting > 0u) {                 /* Make sure we don't create the task from within an ISR  */
+    ptcb = OSTCBFreeList;                    /* Make sure there is a TCB for every entry               */
+    for (i = 0u; (i < nbr) && (ptcb != (OS_TCB *)0); i++) {
+        ptcb = ptcb->OSTCBNext;
+    }
+    if (i < nbr) {
         OS_EXIT_CRITICAL();
-        return (OS_ERR_TASK_CREATE_ISR);
+        rt_exit_critical();
+        return (OS_ERR_TASK_NO_MORE_TCB);
     }
-    if (OSTCBPrioTbl[prio] == (OS_TCB *)0) { /* Make sure task doesn't already exist at this priority  */
-        OSTCBPrioTbl[prio] = OS_TCB_RESERVED;/* Reserve the priority to prevent others from doing ...  */
-    }else{
-        return (OS_ERR_PRIO_EXIST);
+    for (i = 0u; i < nbr; i++) {             /* Reserve all the priorities (also catches duplicates)   */
+        if (OSTCBPrioTbl[ptbl[i].OSTaskCfgPrio] != (OS_TCB *)0) {
+            for (j = 0u; j < i; j++) {       /* Undo the reservations already made                     */
+                OSTCBPrioTbl[ptbl[j].OSTaskCfgPrio] = (OS_TCB *)0;
+            }
+            OS_EXIT_CRITICAL();
+            rt_exit_critical();
+            return (OS_ERR_PRIO_EXIST);
+        }
+        OSTCBPrioTbl[ptbl[i].OSTaskCfgPrio] = OS_TCB_RESERVED;
     }
     OS_EXIT_CRITICAL();
 
-#if OS_STK_GROWTH == 1u                      /* 若为向下增长需要将堆栈首地址转换一下                   */
-    convert = ptos - (stk_size - 1);
+    for (i = 0u; i < nbr; i++) {
+        pcfg = &ptbl[i];
+#if OS_STK_GROWTH == 1u
+        pbos = pcfg->OSTaskCfgStk;
+        ptos = pcfg->OSTaskCfgStk + pcfg->OSTaskCfgStkSize - 1u;
+#else
+        ptos = pcfg->OSTaskCfgStk;
+        pbos = pcfg->OSTaskCfgStk + pcfg->OSTaskCfgStkSize - 1u;
 #endif
-
-    err = OS_TCBInit(prio, ptos, pbos, id, stk_size, pext, opt, &ptcb);
-    if (err == OS_ERR_NONE) {
-        if (OSRunning == OS_TRUE) {          /* Find HPT if multitasking has started                   */
-            OS_Sched();
+        err  = OS_TCBInit(pcfg->OSTaskCfgPrio, ptos, pbos, pcfg->OSTaskCfgId, pcfg->OSTaskCfgStkSize,
+                          (void *)0, pcfg->OSTaskCfgOpt, &ptcb);
+        if (err != OS_ERR_NONE) {            /* Cannot happen, the TCBs were counted above             */
+            OS_ENTER_CRITICAL();
+            for (j = i; j < nbr; j++) {
+                OSTCBPrioTbl[ptbl[j].OSTaskCfgPrio] = (OS_TCB *)0;
+            }
+            OS_EXIT_CRITICAL();
+            rt_exit_critical();
+            return (err);
+        }
+        if (pcfg->OSTaskCfgName != (const char *)0) {
+#if OS_TASK_NAME_EN > 0u
+            ptcb->OSTCBTaskName = (INT8U *)(void *)pcfg->OSTaskCfgName;
+#endif
+            OS_TaskStart(ptcb, pcfg->OSTaskCfgFnct, pcfg->OSTaskCfgArg, pcfg->OSTaskCfgStk,
+                         pcfg->OSTaskCfgStkSize, OS_TASK_TIME_SLICE_DFLT, pcfg->OSTaskCfgName);
+        } else {
+            rt_snprintf(name, RT_NAME_MAX, "uCTask%02d", pcfg->OSTaskCfgPrio);
+            OS_TaskStart(ptcb, pcfg->OSTaskCfgFnct, pcfg->OSTaskCfgArg, pcfg->OSTaskCfgStk,
+                         pcfg->OSTaskCfgStkSize, OS_TASK_TIME_SLICE_DFLT, name);
         }
-    } else {
-        OS_ENTER_CRITICAL();
-        OSTCBPrioTbl[prio] = (OS_TCB *)0;    /* Make this priority avail. to others                    */
-        OS_EXIT_CRITICAL();
-        return (err);
     }
-
-    rt_snprintf(name,RT_NAME_MAX,"uCTask%02d",prio);
-    rt_thread_init(&ptcb->OSTask,name,task,p_arg,convert,stk_size*sizeof(OS_STK),prio,0);
-    rt_thread_startup(&ptcb->OSTask);        /*start the task                                          */
-
+    rt_exit_critical();                      /* Run the highest priority task                          */
     return (OS_ERR_NONE);
 }
 #endif
@@ -389,6 +875,11 @@ INT8U  OSTaskDel (INT8U prio)
         OS_EXIT_CRITICAL();
         return (OS_ERR_TASK_DEL);
     }
+#if (OS_FLAG_EN > 0u)
+    if (ptcb->OSTCBFlagNode != (OS_FLAG_NODE *)0) {     /* If task is waiting on event flag            */
+        OS_FlagUnlink(ptcb->OSTCBFlagNode);             /* Remove from wait list                       */
+    }
+#endif
 #ifndef PKG_USING_UCOSII_WRAPPER_TINY
     ptcb->OSTCBDly      = 0u;                           /* Prevent OSTimeTick() from updating          */
 #endif
@@ -691,6 +1182,76 @@ void  OSTaskNameSet (INT8U   prio,
 #endif
 
 
+/*
+*********************************************************************************************************
+*                                      MAKE A TASK PERIODIC
+*
+* Description: This function sets the release period and the relative deadline of a task.  The task then
+*              calls OSTaskWaitNextPeriod() at the end of each cycle instead of OSTimeDly().
+*
+* Arguments  : prio      is the priority of the task.  You can specify OS_PRIO_SELF.
+*
+*              period    is the release period (in ticks).  0 makes the task non-periodic again.
+*
+*              deadline  is the deadline (in ticks) relative to each release.  0 sets the deadline to
+*                        'period'.
+*
+* Returns    : OS_ERR_NONE                 if the period was set.
+*              OS_ERR_PRIO_INVALID         if the priority you specify is higher that the maximum allowed
+*                                          (i.e. >= OS_LOWEST_PRIO) or, you have not specified OS_PRIO_SELF.
+*              OS_ERR_TASK_NOT_EXIST       if the task does not exist or is assigned to a Mutex PIP.
+*              OS_ERR_TASK_PERIOD_INVALID  if 'deadline' is greater than 'period'.
+*
+* Note(s)    : 1) The current tick is taken as the first release, the statistics of the task are cleared.
+*********************************************************************************************************
+*/
+
+#if OS_TASK_PERIODIC_EN > 0u
+INT8U  OSTaskPeriodSet (INT8U   prio,
+                        INT32U  period,
+                        INT32U  deadline)
+{
+    OS_TCB    *ptcb;
+#if OS_CRITICAL_METHOD == 3u                     /* Allocate storage for CPU status register           */
+    OS_CPU_SR  cpu_sr = 0u;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0u
+    if (prio >= OS_LOWEST_PRIO) {                /* Task priority valid ?                              */
+        if (prio != OS_PRIO_SELF) {
+            return (OS_ERR_PRIO_INVALID);
+        }
+    }
+#endif
+    if (deadline == 0u) {                        /* Implicit deadline                                  */
+        deadline = period;
+    }
+    if (deadline > period) {
+        return (OS_ERR_TASK_PERIOD_INVALID);
+    }
+    OS_ENTER_CRITICAL();
+    if (prio == OS_PRIO_SELF) {                  /* See if changing SELF                               */
+        prio = OSTCBCur->OSTCBPrio;
+    }
+    ptcb = OSTCBPrioTbl[prio];
+    if ((ptcb == (OS_TCB *)0) || (ptcb == OS_TCB_RESERVED)) {
+        OS_EXIT_CRITICAL();
+        return (OS_ERR_TASK_NOT_EXIST);
+    }
+    ptcb->OSTCBPeriod          = period;
+    ptcb->OSTCBDeadline        = deadline;
+    ptcb->OSTCBRelease         = (INT32U)rt_tick_get();
+    ptcb->OSTCBReleaseCtr      = 0uL;
+    ptcb->OSTCBDeadlineMissCtr = 0uL;
+    ptcb->OSTCBRespTimeMax     = 0uL;
+    OS_EXIT_CRITICAL();
+    return (OS_ERR_NONE);
+}
+#endif
+
+
 /*
 *********************************************************************************************************
 *                                       RESUME A SUSPENDED TASK
@@ -737,6 +1298,12 @@ INT8U  OSTaskResume (INT8U prio)
 
     if ((ptcb->OSTCBStat & OS_STAT_SUSPEND) != OS_STAT_RDY) { /* Task must be suspended                */
         ptcb->OSTCBStat &= (INT8U)~(INT8U)OS_STAT_SUSPEND;    /* Remove suspension                     */
+#if OS_TASK_BUDGET_EN > 0u
+        if (ptcb->OSTCBBudgetThrottled == OS_TRUE) {          /* Replenishment will resume the task    */
+            OS_EXIT_CRITICAL();
+            return (OS_ERR_NONE);
+        }
+#endif
         if ((ptcb->OSTCBStat & OS_STAT_PEND_ANY) == OS_STAT_RDY) { /* See if task is now ready         */
             OS_EXIT_CRITICAL();
             rt_thread_resume((rt_thread_t)ptcb);              /* rt-thread thread resume API           */
@@ -771,6 +1338,17 @@ INT8U  OSTaskResume (INT8U prio)
 *              OS_ERR_TASK_NOT_EXIST  if the desired task has not been created or is assigned to a Mutex PIP
 *              OS_ERR_TASK_OPT        if you did NOT specified OS_TASK_OPT_STK_CHK when the task was created
 *              OS_ERR_PDATA_NULL      if 'p_stk_data' is a NULL pointer
+*
+* Note(s)    : 1) The stack is compared one OS_STK entry at a time against the pattern RT-Thread fills it
+*                 with, scanning up from the bottom of the stack.  The result is cached in the TCB
+*                 (OSTCBStkFree).  Because the high-water mark can only get deeper, later calls first
+*                 test the highest entry found free last time: if it still holds the pattern the cached
+*                 result is returned at once, otherwise only the entries below it are scanned again.
+*              2) When OS_TASK_STK_CHK_WINDOW is not 0, every scan is bounded by that many entries from
+*                 the bottom of the stack.  If they are all unused, OSFree is OS_TASK_STK_CHK_WINDOW and
+*                 means 'at least that many entries free' (OSUsed is then an upper bound), on this call
+*                 and on every later call until the task uses an entry inside the window.  This bounds the
+*                 cost of checking large stacks which are mostly unused.
 *********************************************************************************************************
 */
 #if (OS_TASK_STAT_STK_CHK_EN > 0u) && (OS_TASK_CREATE_EXT_EN > 0u)
@@ -778,9 +1356,11 @@ INT8U  OSTaskStkChk (INT8U         prio,
                      OS_STK_DATA  *p_stk_data)
 {
     OS_TCB    *ptcb;
-    char      *pchk;
+    OS_STK    *pbos;
+    OS_STK    *pchk;
     INT32U     nfree;
     INT32U     size;
+    INT32U     nmax;
 #if OS_CRITICAL_METHOD == 3u                           /* Allocate storage for CPU status register     */
     OS_CPU_SR  cpu_sr = 0u;
 #endif
@@ -816,20 +1396,48 @@ INT8U  OSTaskStkChk (INT8U         prio,
         OS_EXIT_CRITICAL();
         return (OS_ERR_TASK_OPT);
     }
-    nfree = 0u;
     size  = ptcb->OSTCBStkSize;
-    pchk  = (char*)ptcb->OSTCBStkBottom;
+    nfree = ptcb->OSTCBStkFree;                        /* Watermark found by the previous check        */
+    pbos  = ptcb->OSTCBStkBottom;
     OS_EXIT_CRITICAL();
+    nmax  = size;
+    if (nfree <= size) {                               /* Watermark known from a previous check        */
+        if (nfree > 0u) {
 #if OS_STK_GROWTH == 1u
-    while (*pchk++ == '#') {                           /* Compute the number of zero entries on the stk */
-        nfree++;
+            pchk = pbos + (nfree - 1u);                /* Highest free entry found last time           */
+#else
+            pchk = pbos - (nfree - 1u);
+#endif
+        }
+        if ((nfree == 0u) || (*pchk == OS_STK_FILL)) { /* Watermark didn't move: return it as is       */
+            p_stk_data->OSFree = nfree;
+            p_stk_data->OSUsed = size - nfree;
+            return (OS_ERR_NONE);
+        }
+        nmax = nfree - 1u;                             /* Task went deeper: rescan below the watermark */
+    }
+#if OS_TASK_STK_CHK_WINDOW > 0u
+    if (nmax > OS_TASK_STK_CHK_WINDOW) {               /* Only scan the window at the bottom           */
+        nmax = OS_TASK_STK_CHK_WINDOW;
     }
+#endif
+    nfree = 0u;                                        /* Count fill entries up from the bottom        */
+    pchk  = pbos;
+    while ((nfree < nmax) && (*pchk == OS_STK_FILL)) {
+#if OS_STK_GROWTH == 1u
+        pchk++;
 #else
-    while (*pchk-- == '#') {
+        pchk--;
+#endif
         nfree++;
     }
-#endif
-    nfree = nfree / sizeof(OS_STK);                   /* RT-Thread与uCOS-II堆栈大小的单位不一样        */
+    OS_ENTER_CRITICAL();
+    if ((OSTCBPrioTbl[prio] == ptcb) &&                /* Cache the watermark if the task still exists */
+        (ptcb->OSTCBStkBottom == pbos) &&
+        (nfree < ptcb->OSTCBStkFree)) {
+        ptcb->OSTCBStkFree = nfree;
+    }
+    OS_EXIT_CRITICAL();
     p_stk_data->OSFree = nfree;                       /* Store   number of free entries on the stk     */
     p_stk_data->OSUsed = size - nfree;                /* Compute number of entries used on the stk     */
     return (OS_ERR_NONE);
@@ -837,6 +1445,187 @@ INT8U  OSTaskStkChk (INT8U         prio,
 #endif
 
 
+/*
+*********************************************************************************************************
+*                                       ADD A TASK TO A TASK GROUP
+*
+* Description: This function adds a task to a task group.
+*
+* Arguments  : pgrp      is a pointer to the task group.
+*
+*              prio      is the priority of the task to add.  You can specify OS_PRIO_SELF.
+*
+* Returns    : OS_ERR_NONE            if the task was added (or already was in the group).
+*              OS_ERR_PDATA_NULL      if 'pgrp' is a NULL pointer.
+*              OS_ERR_PRIO_INVALID    if the priority you specify is higher that the maximum allowed
+*                                     (i.e. >= OS_LOWEST_PRIO) or, you have not specified OS_PRIO_SELF.
+*              OS_ERR_TASK_GRP_FULL   if the group already holds OS_TASK_GRP_SIZE tasks.
+*
+* Note(s)    : 1) The group records priorities: a task whose priority is changed must be added again.
+*********************************************************************************************************
+*/
+
+#if OS_TASK_GRP_EN > 0u
+INT8U  OSTaskGroupAdd (OS_TASK_GRP  *pgrp,
+                       INT8U         prio)
+{
+    INT8U      i;
+#if OS_CRITICAL_METHOD == 3u                     /* Allocate storage for CPU status register           */
+    OS_CPU_SR  cpu_sr = 0u;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0u
+    if (pgrp == (OS_TASK_GRP *)0) {              /* Validate 'pgrp'                                    */
+        return (OS_ERR_PDATA_NULL);
+    }
+    if (prio >= OS_LOWEST_PRIO) {                /* Task priority valid ?                              */
+        if (prio != OS_PRIO_SELF) {
+            return (OS_ERR_PRIO_INVALID);
+        }
+    }
+#endif
+    OS_ENTER_CRITICAL();
+    if (prio == OS_PRIO_SELF) {                  /* See if adding SELF                                 */
+        prio = OSTCBCur->OSTCBPrio;
+    }
+    for (i = 0u; i < pgrp->OSGrpNbr; i++) {
+        if (pgrp->OSGrpPrioTbl[i] == prio) {     /* Already a member                                   */
+            OS_EXIT_CRITICAL();
+            return (OS_ERR_NONE);
+        }
+    }
+    if (pgrp->OSGrpNbr >= OS_TASK_GRP_SIZE) {
+        OS_EXIT_CRITICAL();
+        return (OS_ERR_TASK_GRP_FULL);
+    }
+    pgrp->OSGrpPrioTbl[pgrp->OSGrpNbr] = prio;
+    pgrp->OSGrpNbr++;
+    OS_EXIT_CRITICAL();
+    return (OS_ERR_NONE);
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                         CREATE A TASK GROUP
+*
+* Description: This function initializes an empty task group.
+*
+* Arguments  : pgrp      is a pointer to the task group.
+*
+* Returns    : OS_ERR_NONE            if the group was initialized.
+*              OS_ERR_PDATA_NULL      if 'pgrp' is a NULL pointer.
+*********************************************************************************************************
+*/
+
+#if OS_TASK_GRP_EN > 0u
+INT8U  OSTaskGroupCreate (OS_TASK_GRP  *pgrp)
+{
+#if OS_ARG_CHK_EN > 0u
+    if (pgrp == (OS_TASK_GRP *)0) {              /* Validate 'pgrp'                                    */
+        return (OS_ERR_PDATA_NULL);
+    }
+#endif
+    pgrp->OSGrpNbr = 0u;
+    return (OS_ERR_NONE);
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                       RESUME ALL TASKS OF A GROUP
+*
+* Description: This function resumes all the tasks of a task group that were suspended.  The scheduler is
+*              locked while the tasks are resumed, so other tasks never see part of the group resumed, and
+*              a single reschedule takes place at the end.
+*
+* Arguments  : pgrp      is a pointer to the task group.
+*
+* Returns    : OS_ERR_NONE            if every task of the group was resumed or was not suspended.
+*              OS_ERR_PDATA_NULL      if 'pgrp' is a NULL pointer.
+*              Otherwise, the error returned by OSTaskResume() for the last task that could not be
+*              resumed (e.g. because it was deleted).  The other tasks are resumed anyway.
+*********************************************************************************************************
+*/
+
+#if OS_TASK_GRP_EN > 0u
+INT8U  OSTaskGroupResume (OS_TASK_GRP  *pgrp)
+{
+    INT8U  i;
+    INT8U  err;
+    INT8U  err_grp;
+
+
+#if OS_ARG_CHK_EN > 0u
+    if (pgrp == (OS_TASK_GRP *)0) {              /* Validate 'pgrp'                                    */
+        return (OS_ERR_PDATA_NULL);
+    }
+#endif
+    err_grp = OS_ERR_NONE;
+    OSSchedLock();                               /* OSTaskResume() won't switch with the sched. locked */
+    for (i = 0u; i < pgrp->OSGrpNbr; i++) {
+        err = OSTaskResume(pgrp->OSGrpPrioTbl[i]);
+        if ((err != OS_ERR_NONE) && (err != OS_ERR_TASK_NOT_SUSPENDED)) {
+            err_grp = err;
+        }
+    }
+    OSSchedUnlock();                             /* Single reschedule                                  */
+    return (err_grp);
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                      SUSPEND ALL TASKS OF A GROUP
+*
+* Description: This function suspends all the tasks of a task group.  The scheduler is locked while the
+*              tasks are suspended, so other tasks never see part of the group suspended, and a single
+*              reschedule takes place at the end.
+*
+* Arguments  : pgrp      is a pointer to the task group.
+*
+* Returns    : OS_ERR_NONE            if every task of the group was suspended.
+*              OS_ERR_PDATA_NULL      if 'pgrp' is a NULL pointer.
+*              Otherwise, the error returned by OSTaskSuspend() for the last task that could not be
+*              suspended (e.g. because it was deleted).  The other tasks are suspended anyway.
+*
+* Note(s)    : 1) If the calling task is in the group it is suspended too, when this function unlocks the
+*                 scheduler.
+*********************************************************************************************************
+*/
+
+#if OS_TASK_GRP_EN > 0u
+INT8U  OSTaskGroupSuspend (OS_TASK_GRP  *pgrp)
+{
+    INT8U  i;
+    INT8U  err;
+    INT8U  err_grp;
+
+
+#if OS_ARG_CHK_EN > 0u
+    if (pgrp == (OS_TASK_GRP *)0) {              /* Validate 'pgrp'                                    */
+        return (OS_ERR_PDATA_NULL);
+    }
+#endif
+    err_grp = OS_ERR_NONE;
+    OSSchedLock();                               /* OSTaskSuspend() won't switch with the sched. locked*/
+    for (i = 0u; i < pgrp->OSGrpNbr; i++) {
+        err = OSTaskSuspend(pgrp->OSGrpPrioTbl[i]);
+        if (err != OS_ERR_NONE) {
+            err_grp = err;
+        }
+    }
+    OSSchedUnlock();                             /* Single reschedule                                  */
+    return (err_grp);
+}
+#endif
+
+
 /*
 *********************************************************************************************************
 *                                           SUSPEND A TASK
@@ -926,6 +1715,10 @@ INT8U  OSTaskSuspend (INT8U prio)
 *              OS_ERR_PRIO            if the desired task has not been created
 *              OS_ERR_TASK_NOT_EXIST  if the task is assigned to a Mutex PIP
 *              OS_ERR_PDATA_NULL      if 'p_task_data' is a NULL pointer
+*
+* Note(s)    : 1) When OS_TASK_PROFILE_EN is set, the copy includes the run time statistics of the task:
+*                 OSTCBCPUUsage (in % over the last statistic task sample), OSTCBCyclesTot and
+*                 OSTCBCtxSwCtr.
 *********************************************************************************************************
 */
 
@@ -971,6 +1764,91 @@ INT8U  OSTaskQuery (INT8U    prio,
 #endif
 
 
+/*
+*********************************************************************************************************
+*                                          QUERY ALL TASKS
+*
+* Description: This function is called to obtain a consistent snapshot of every task.  Instead of copying
+*              whole TCBs one priority at a time, OSTCBList is walked once within a single critical
+*              section and only a compact record is stored for each task.
+*
+* Arguments  : p_snap       is a pointer to an array of 'max' OS_TASK_SNAPSHOT records.
+*
+*              max          is the number of records 'p_snap' can hold.
+*
+* Returns    : The number of records stored in 'p_snap' (0 if 'p_snap' is a NULL pointer).
+*
+* Note(s)    : 1) 'OSStkUsed' is the high-water mark cached by the last OSTaskStkChk() of the task (e.g.
+*                 done by the statistic task), no stack is scanned here.
+*              2) 'OSPendObj' is only known for event flag groups when PKG_USING_UCOSII_WRAPPER_TINY is
+*                 defined.
+*              3) Fields whose feature is disabled (OS_TASK_PROFILE_EN, OS_TASK_CREATE_EXT_EN) are 0.
+*********************************************************************************************************
+*/
+
+#if OS_TASK_QUERY_EN > 0u
+INT8U  OSTaskQueryAll (OS_TASK_SNAPSHOT  *p_snap,
+                       INT8U              max)
+{
+    OS_TCB    *ptcb;
+    INT8U      n;
+#if OS_CRITICAL_METHOD == 3u                     /* Allocate storage for CPU status register           */
+    OS_CPU_SR  cpu_sr = 0u;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0u
+    if (p_snap == (OS_TASK_SNAPSHOT *)0) {       /* Validate 'p_snap'                                  */
+        return (0u);
+    }
+#endif
+    n = 0u;
+    OS_ENTER_CRITICAL();
+    ptcb = OSTCBList;
+    while ((ptcb != (OS_TCB *)0) && (n < max)) {
+        p_snap->OSPendObj  = (void *)0;
+#ifndef PKG_USING_UCOSII_WRAPPER_TINY
+#if (OS_EVENT_EN)
+        p_snap->OSPendObj  = (void *)ptcb->OSTCBEventPtr;
+#endif
+#endif
+#if (OS_FLAG_EN > 0u)
+        if (ptcb->OSTCBFlagNode != (OS_FLAG_NODE *)0) {
+            p_snap->OSPendObj = ptcb->OSTCBFlagNode->OSFlagNodeFlagGrp;
+        }
+#endif
+#if OS_TASK_CREATE_EXT_EN > 0u
+        p_snap->OSStkSize  = ptcb->OSTCBStkSize;
+        if (ptcb->OSTCBStkFree <= ptcb->OSTCBStkSize) {
+            p_snap->OSStkUsed = ptcb->OSTCBStkSize - ptcb->OSTCBStkFree;
+        } else {
+            p_snap->OSStkUsed = 0u;              /* Stack not checked yet                              */
+        }
+#else
+        p_snap->OSStkSize  = 0u;
+        p_snap->OSStkUsed  = 0u;
+#endif
+#if OS_TASK_PROFILE_EN > 0u
+        p_snap->OSCtxSwCtr = ptcb->OSTCBCtxSwCtr;
+        p_snap->OSCPUUsage = ptcb->OSTCBCPUUsage;
+#else
+        p_snap->OSCtxSwCtr = 0u;
+        p_snap->OSCPUUsage = 0u;
+#endif
+        p_snap->OSPrio     = ptcb->OSTCBPrio;
+        p_snap->OSStat     = ptcb->OSTCBStat;
+        p_snap->OSStatPend = ptcb->OSTCBStatPend;
+        p_snap++;
+        n++;
+        ptcb = ptcb->OSTCBNext;
+    }
+    OS_EXIT_CRITICAL();
+    return (n);
+}
+#endif
+
+
 /*
 *********************************************************************************************************
 *                              GET THE CURRENT VALUE OF A TASK REGISTER
@@ -1162,3 +2040,429 @@ void  OSTaskRegSet (INT8U    prio,
     *perr                 = OS_ERR_NONE;
 }
 #endif
+
+
+/*
+*********************************************************************************************************
+*                                       CHANGE A TASK'S TIME SLICE
+*
+* Description: This function is called to change the round-robin time slice of a task at run-time.
+*
+* Arguments  : prio        is the priority of the task.  You can specify OS_PRIO_SELF.
+*
+*              time_slice  is the new time slice (in ticks).  0 selects OS_TASK_TIME_SLICE_DFLT.
+*
+* Returns    : OS_ERR_NONE            if the time slice was changed.
+*              OS_ERR_PRIO_INVALID    if the priority you specify is higher that the maximum allowed
+*                                     (i.e. >= OS_LOWEST_PRIO) or, you have not specified OS_PRIO_SELF.
+*              OS_ERR_TASK_NOT_EXIST  if the task does not exist or is assigned to a Mutex PIP.
+*
+* Note(s)    : 1) The new time slice also replaces what is left of the current one.
+*********************************************************************************************************
+*/
+
+#if OS_TASK_TIME_SLICE_EN > 0u
+INT8U  OSTaskTimeSliceSet (INT8U   prio,
+                           INT32U  time_slice)
+{
+    OS_TCB    *ptcb;
+#if OS_CRITICAL_METHOD == 3u                     /* Allocate storage for CPU status register           */
+    OS_CPU_SR  cpu_sr = 0u;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0u
+    if (prio >= OS_LOWEST_PRIO) {                /* Task priority valid ?                              */
+        if (prio != OS_PRIO_SELF) {
+            return (OS_ERR_PRIO_INVALID);
+        }
+    }
+#endif
+    if (time_slice == 0u) {
+        time_slice = OS_TASK_TIME_SLICE_DFLT;
+    }
+    OS_ENTER_CRITICAL();
+    if (prio == OS_PRIO_SELF) {                  /* See if changing SELF                               */
+        prio = OSTCBCur->OSTCBPrio;
+    }
+    ptcb = OSTCBPrioTbl[prio];
+    if ((ptcb == (OS_TCB *)0) || (ptcb == OS_TCB_RESERVED)) {
+        OS_EXIT_CRITICAL();
+        return (OS_ERR_TASK_NOT_EXIST);
+    }
+    ptcb->OSTask.init_tick      = time_slice;    /* RT-Thread reloads the slice from 'init_tick'       */
+    ptcb->OSTask.remaining_tick = time_slice;
+    OS_EXIT_CRITICAL();
+    return (OS_ERR_NONE);
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                    WAIT FOR THE NEXT PERIOD OF A TASK
+*
+* Description: This function is called by a periodic task (see OSTaskPeriodSet()) when it is done with the
+*              current cycle.  The task is delayed until the next release, which is an absolute multiple of
+*              the period from the first release; the time spent working thus does not make the task
+*              drift.
+*
+*              The response time of the cycle (from its release to this call) is compared to the deadline.
+*              A late cycle is counted in OSTCBDeadlineMissCtr and reported to OSTaskDeadlineMissHook().
+*
+* Arguments  : none
+*
+* Returns    : OS_ERR_NONE                 if the task was delayed until its next release.
+*              OS_ERR_TIME_DLY_ISR         if you called this function from an ISR.
+*              OS_ERR_SCHED_LOCKED         if you called this function with the scheduler locked.
+*              OS_ERR_TASK_NOT_PERIODIC    if the calling task has no period.
+*
+* Note(s)    : 1) A cycle that overran one or more periods does not get the releases it missed, the task is
+*                 released on the next period boundary that is still ahead.
+*              2) OSTaskDeadlineMissHook() is called with interrupts enabled and may change the period of
+*                 the task with OSTaskPeriodSet(), e.g. to degrade gracefully.
+*********************************************************************************************************
+*/
+
+#if OS_TASK_PERIODIC_EN > 0u
+INT8U  OSTaskWaitNextPeriod (void)
+{
+    OS_TCB    *ptcb;
+    INT32U     now;
+    INT32U     resp;
+    INT32U     next;
+    BOOLEAN    miss;
+#if OS_CRITICAL_METHOD == 3u                     /* Allocate storage for CPU status register           */
+    OS_CPU_SR  cpu_sr = 0u;
+#endif
+
+
+
+    if (OSIntNesting > 0u) {                     /* See if trying to call from an ISR                  */
+        return (OS_ERR_TIME_DLY_ISR);
+    }
+    if (OSLockNesting > 0u) {                    /* See if called with scheduler locked                */
+        return (OS_ERR_SCHED_LOCKED);
+    }
+    ptcb = OSTCBCur;
+    OS_ENTER_CRITICAL();
+    if (ptcb->OSTCBPeriod == 0u) {
+        OS_EXIT_CRITICAL();
+        return (OS_ERR_TASK_NOT_PERIODIC);
+    }
+    resp = (INT32U)rt_tick_get() - ptcb->OSTCBRelease;           /* Response time of this cycle        */
+    if (resp > ptcb->OSTCBRespTimeMax) {
+        ptcb->OSTCBRespTimeMax = resp;
+    }
+    miss = OS_FALSE;
+    if (resp > ptcb->OSTCBDeadline) {
+        ptcb->OSTCBDeadlineMissCtr++;
+        miss = OS_TRUE;
+    }
+    OS_EXIT_CRITICAL();
+    if (miss == OS_TRUE) {
+        OSTaskDeadlineMissHook(ptcb);
+    }
+
+    OS_ENTER_CRITICAL();
+    if (ptcb->OSTCBPeriod == 0u) {               /* Hook made the task non-periodic                    */
+        OS_EXIT_CRITICAL();
+        return (OS_ERR_TASK_NOT_PERIODIC);
+    }
+    now  = (INT32U)rt_tick_get();
+    resp = now - ptcb->OSTCBRelease;
+    next = ptcb->OSTCBRelease                    /* First period boundary that is still ahead          */
+         + (resp / ptcb->OSTCBPeriod + 1u) * ptcb->OSTCBPeriod;
+    ptcb->OSTCBRelease = next;
+    ptcb->OSTCBReleaseCtr++;
+    OS_EXIT_CRITICAL();
+    rt_thread_delay((rt_tick_t)(next - now));    /* 'next' is at least one tick ahead of 'now'         */
+    return (OS_ERR_NONE);
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                     CREATE A TASK (COMMON PART)
+*
+* Description: This function is called by OSTaskCreate() and OSTaskCreateExt() to reserve the priority,
+*              initialize the TCB and create/start the RT-Thread thread that runs the task.
+*
+* Arguments  : see OSTaskCreateExt2().  'stk_size' is the number of stack elements from 'ptos' to the
+*              other end of the stack.
+*
+* Returns    : see OSTaskCreateExt().
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*********************************************************************************************************
+*/
+
+static  INT8U  OS_TaskCreate (void   (*task)(void *p_arg),
+                              void    *p_arg,
+                              OS_STK  *ptos,
+                              INT8U    prio,
+                              INT16U   id,
+                              OS_STK  *pbos,
+                              INT32U   stk_size,
+                              void    *pext,
+                              INT16U   opt,
+                              INT32U   time_slice)
+{
+    INT8U       err;
+    OS_TCB     *ptcb;
+    OS_STK     *pstk_base;
+    char        name[RT_NAME_MAX];
+#if OS_CRITICAL_METHOD == 3u                 /* Allocate storage for CPU status register               */
+    OS_CPU_SR   cpu_sr = 0u;
+#endif
+
+
+    OS_ENTER_CRITICAL();
+    if (OSIntNesting > 0u) {                 /* Make sure we don't create the task from within an ISR  */
+        OS_EXIT_CRITICAL();
+        return (OS_ERR_TASK_CREATE_ISR);
+    }
+    if (OSTCBPrioTbl[prio] != (OS_TCB *)0) { /* Make sure task doesn't already exist at this priority  */
+        OS_EXIT_CRITICAL();
+        return (OS_ERR_PRIO_EXIST);
+    }
+    OSTCBPrioTbl[prio] = OS_TCB_RESERVED;    /* Reserve the priority to prevent others from doing ...  */
+    OS_EXIT_CRITICAL();
+
+#if OS_STK_GROWTH == 1u                      /* RT-Thread needs the lowest address of the stack        */
+    pstk_base = ptos - (stk_size - 1u);
+#else
+    pstk_base = ptos;
+#endif
+
+    err = OS_TCBInit(prio, ptos, pbos, id, stk_size, pext, opt, &ptcb);
+    if (err != OS_ERR_NONE) {
+        OS_ENTER_CRITICAL();
+        OSTCBPrioTbl[prio] = (OS_TCB *)0;    /* Make this priority avail. to others                    */
+        OS_EXIT_CRITICAL();
+        return (err);
+    }
+
+    if (time_slice == 0u) {                  /* Use the default time slice if none specified           */
+        time_slice = OS_TASK_TIME_SLICE_DFLT;
+    }
+    rt_snprintf(name, RT_NAME_MAX, "uCTask%02d", prio);
+    OS_TaskStart(ptcb, task, p_arg, pstk_base, stk_size, time_slice, name);
+
+    if (OSRunning == OS_TRUE) {              /* Find HPT if multitasking has started                   */
+        OS_Sched();
+    }
+    return (OS_ERR_NONE);
+}
+
+
+/*
+*********************************************************************************************************
+*                                     START THE THREAD OF A TASK
+*
+* Description: This function initializes the RT-Thread thread embedded in the TCB of a new task and starts
+*              it, unless OS_START_DEFER_EN holds the task back until OSStart().
+*
+* Arguments  : ptcb        is a pointer to the TCB of the task.
+*
+*              task        is a pointer to the task's code.
+*
+*              p_arg       is the argument passed to the task.
+*
+*              pstk_base   is the LOWEST memory location of the task's stack.
+*
+*              stk_size    is the size of the stack in number of OS_STK elements.
+*
+*              time_slice  is the round-robin time slice of the task (in ticks).
+*
+*              name        is the name of the thread.
+*
+* Returns    : none
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*********************************************************************************************************
+*/
+
+static  void  OS_TaskStart (OS_TCB      *ptcb,
+                            void       (*task)(void *p_arg),
+                            void        *p_arg,
+                            OS_STK      *pstk_base,
+                            INT32U       stk_size,
+                            INT32U       time_slice,
+                            const char  *name)
+{
+    rt_thread_init(&ptcb->OSTask, name, task, p_arg, pstk_base, stk_size * sizeof(OS_STK),
+                   OS_PRIO_TO_RT(ptcb->OSTCBPrio), time_slice);
+#if OS_START_DEFER_EN > 0u
+    if (OSRunning == OS_FALSE) {             /* OSStart() will start the task                          */
+        return;
+    }
+#endif
+    rt_thread_startup(&ptcb->OSTask);        /* Start the task                                         */
+}
+
+
+/*
+*********************************************************************************************************
+*                                  FIND THE EXTENT OF AN OSTaskCreate() STACK
+*
+* Description: This function determines the bottom and the size of the stack whose top is 'ptos'.
+*
+* Arguments  : ptos       is the top of stack passed to OSTaskCreate().
+*
+*              ppbos      receives the bottom of stack.
+*
+*              pstk_size  receives the number of stack elements between 'ptos' and '*ppbos' (inclusive).
+*
+* Returns    : OS_ERR_NONE              if the extent of the stack is known.
+*              OS_ERR_TASK_STK_NOT_REG  if 'ptos' is not inside a registered stack and no default stack
+*                                       size is configured (OS_TASK_CREATE_STK_SIZE == 0).
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*********************************************************************************************************
+*/
+
+#if OS_TASK_CREATE_EN > 0u
+static  INT8U  OS_TaskStkFind (OS_STK  *ptos,
+                              OS_STK **ppbos,
+                              INT32U  *pstk_size)
+{
+    INT32U      stk_size;
+#if OS_TASK_STK_REG_MAX > 0u
+    OS_STK_REG *preg;
+    INT8U       i;
+#if OS_CRITICAL_METHOD == 3u                 /* Allocate storage for CPU status register               */
+    OS_CPU_SR   cpu_sr = 0u;
+#endif
+#endif
+
+
+    stk_size = OS_TASK_CREATE_STK_SIZE;      /* Assume the default stack size, if any                  */
+#if OS_TASK_STK_REG_MAX > 0u
+    OS_ENTER_CRITICAL();
+    for (i = 0u; i < OSTaskStkRegCtr; i++) { /* Look for a registered stack holding 'ptos'             */
+        preg = &OSTaskStkRegTbl[i];
+        if ((ptos >= preg->OSStkRegBase) &&
+            (ptos <  (preg->OSStkRegBase + preg->OSStkRegSize))) {
+#if OS_STK_GROWTH == 1u
+            stk_size = (INT32U)(ptos - preg->OSStkRegBase) + 1u;
+#else
+            stk_size = (INT32U)((preg->OSStkRegBase + preg->OSStkRegSize) - ptos);
+#endif
+            break;
+        }
+    }
+    OS_EXIT_CRITICAL();
+#endif
+    if (stk_size == 0u) {                    /* Don't guess the size of an unregistered stack          */
+        return (OS_ERR_TASK_STK_NOT_REG);
+    }
+
+#if OS_STK_GROWTH == 1u
+    *ppbos     = ptos - (stk_size - 1u);
+#else
+    *ppbos     = ptos + (stk_size - 1u);
+#endif
+    *pstk_size = stk_size;
+    return (OS_ERR_NONE);
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                      INITIALIZE THE CPU BUDGET TIMER
+*
+* Description: This function is called by OSInit() to create the timer that drives OSTaskBudgetSet().  The
+*              timer is only running while at least one task has a budget.
+*
+* Arguments  : none
+*
+* Returns    : none
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*********************************************************************************************************
+*/
+
+#if OS_TASK_BUDGET_EN > 0u
+void  OS_TaskBudgetInit (void)
+{
+    rt_timer_init(&OSTaskBudgetTmr, "uCOS-II Budget",
+                  OS_TaskBudgetTick, RT_NULL, 1u,
+                  RT_TIMER_FLAG_PERIODIC | RT_TIMER_FLAG_HARD_TIMER);
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                    CHARGE AND REPLENISH THE CPU BUDGETS
+*
+* Description: This function is called on every tick (from the tick ISR) while a budget is set.  It
+*              charges the tick to the interrupted task, throttles that task if its budget is exhausted and
+*              replenishes the budget of every task whose period has ended.  It stops its own timer when
+*              no task has a budget any more (budgets removed or budgeted tasks deleted).
+*
+* Arguments  : parameter  is not used.
+*
+* Returns    : none
+*********************************************************************************************************
+*/
+
+#if OS_TASK_BUDGET_EN > 0u
+static  void  OS_TaskBudgetTick (void  *parameter)
+{
+    OS_TCB    *ptcb;
+    BOOLEAN    sched;
+    BOOLEAN    active;
+#if OS_CRITICAL_METHOD == 3u                     /* Allocate storage for CPU status register           */
+    OS_CPU_SR  cpu_sr = 0u;
+#endif
+
+
+    parameter = parameter;                       /* Prevent compiler warning for not using 'parameter' */
+    sched     = OS_FALSE;
+    active    = OS_FALSE;
+    OS_ENTER_CRITICAL();
+    ptcb = OS_TCBFromThread(rt_thread_self());   /* Charge the tick to the interrupted task            */
+    if (ptcb != (OS_TCB *)0) {
+        if (ptcb->OSTCBBudgetLeft > 0u) {
+            ptcb->OSTCBBudgetLeft--;
+            if (ptcb->OSTCBBudgetLeft == 0u) {   /* Budget exhausted, throttle the task                */
+                ptcb->OSTCBBudgetThrottled = OS_TRUE;
+                ptcb->OSTCBBudgetOvrCtr++;
+                rt_thread_suspend(&ptcb->OSTask);
+                sched = OS_TRUE;
+            }
+        }
+    }
+    ptcb = OSTCBList;
+    while (ptcb != (OS_TCB *)0) {                /* Replenish the budgets whose period has ended       */
+        if (ptcb->OSTCBBudget > 0u) {
+            active = OS_TRUE;
+            ptcb->OSTCBBudgetPeriodLeft--;
+            if (ptcb->OSTCBBudgetPeriodLeft == 0u) {
+                ptcb->OSTCBBudgetPeriodLeft = ptcb->OSTCBBudgetPeriod;
+                ptcb->OSTCBBudgetLeft       = ptcb->OSTCBBudget;
+                if (ptcb->OSTCBBudgetThrottled == OS_TRUE) {
+                    ptcb->OSTCBBudgetThrottled = OS_FALSE;
+                    if ((ptcb->OSTCBStat & OS_STAT_SUSPEND) == OS_STAT_RDY) {
+                        rt_thread_resume(&ptcb->OSTask);
+                        sched = OS_TRUE;
+                    }
+                }
+            }
+        }
+        ptcb = ptcb->OSTCBNext;
+    }
+    if (active == OS_FALSE) {                    /* No budget left (removed or task deleted) ...       */
+        rt_timer_stop(&OSTaskBudgetTmr);         /* ... stop charging ticks until the next one is set  */
+    }
+    OS_EXIT_CRITICAL();
+    if (sched == OS_TRUE) {
+        rt_schedule();                           /* Switch at the end of the tick ISR                  */
+    }
+}
+#endif
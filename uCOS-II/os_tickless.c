@@ -0,0 +1,187 @@
+/*
+ * Copyright (c) 2021, Meco Jianting Man <jiantingman@foxmail.com>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+/*
+*********************************************************************************************************
+*                                              uC/OS-II
+*                                        The Real-Time Kernel
+*
+*                    Copyright 1992-2020 Silicon Laboratories Inc. www.silabs.com
+*
+*                                 SPDX-License-Identifier: APACHE-2.0
+*
+*               This software is subject to an open source license and is distributed by
+*                Silicon Laboratories Inc. pursuant to the terms of the Apache License,
+*                    Version 2.0 available at www.apache.org/licenses/LICENSE-2.0.
+*
+*********************************************************************************************************
+*/
+
+
+/*
+*********************************************************************************************************
+*
+*                                             TICKLESS IDLE
+*
+* Filename : os_tickless.c
+* Version  : V2.93.00
+*********************************************************************************************************
+* Note(s)  : 1) The idle hook runs whenever the RT-Thread idle thread runs, which does not mean that no
+*               other thread is ready: the statistic task (OS_TASK_STAT_PRIO) and any other thread at the
+*               idle priority share the CPU with the idle thread.  The tick is thus only stopped when the
+*               idle thread is the only ready thread.  The next thing that can then make a thread ready is
+*               either an interrupt or the first RT-Thread timer to expire: the timers of the delayed or
+*               pending threads, OS_TMR timers (run by the RT-Thread timer thread, which itself sleeps
+*               until its next timer) and the wrapper's own timers.  rt_timer_next_timeout_tick() returns
+*               that first expiry.
+*
+*            2) OS_TicklessIdle() asks the BSP (OS_CPU_TicklessSleep()) to stop the periodic tick and to
+*               sleep until then, and accounts for all the ticks slept at once when the CPU wakes up.
+*
+*            3) OS_TicklessTicks() only does arithmetic and OS_CPU_TicklessSleep() is RT_WEAK, so the
+*               logic can be run on a host with a simulated clock.
+*
+*            4) While the tick is stopped the idle hook does not run, so OSIdleCtr no longer measures the
+*               idle time and OSCPUUsage is meaningless.  OSTimeTickHook() and a CPU budget
+*               (OSTaskBudgetSet()) are driven by one-tick timers: OS_TIME_TICK_HOOK_EN must be 0 and an
+*               active budget prevents tickless sleep.
+*********************************************************************************************************
+*/
+
+#include "ucos_ii.h"
+
+#if OS_TICKLESS_EN > 0u
+
+extern  rt_list_t    rt_thread_priority_table[RT_THREAD_PRIORITY_MAX];   /* RT-Thread ready lists      */
+extern  rt_uint32_t  rt_thread_ready_priority_group;                     /* RT-Thread ready bitmap     */
+#if RT_THREAD_PRIORITY_MAX > 32
+extern  rt_uint8_t   rt_thread_ready_table[32];
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                        CHECK FOR OTHER READY THREADS
+*
+* Description: This function determines whether the idle thread is the only ready thread.
+*
+* Arguments  : none
+*
+* Returns    : OS_TRUE   if no thread other than the idle thread is ready.
+*              OS_FALSE  otherwise.
+*
+* Note(s)    : 1) Interrupts MUST be disabled when calling this function.
+*              2) The idle thread runs at the lowest RT-Thread priority (RT_THREAD_PRIORITY_MAX - 1) and, as
+*                 the running thread, stays in the ready list of that priority.
+*********************************************************************************************************
+*/
+
+static  BOOLEAN  OS_TicklessIdleOnly (void)
+{
+#if RT_THREAD_PRIORITY_MAX > 32
+    if (rt_thread_ready_priority_group != (1uL << ((RT_THREAD_PRIORITY_MAX - 1u) >> 3))) {
+        return (OS_FALSE);                       /* A higher priority group is ready                   */
+    }
+    if (rt_thread_ready_table[(RT_THREAD_PRIORITY_MAX - 1u) >> 3] !=
+        (rt_uint8_t)(1u << ((RT_THREAD_PRIORITY_MAX - 1u) & 7u))) {
+        return (OS_FALSE);                       /* A higher priority in the idle group is ready       */
+    }
+#else
+    if (rt_thread_ready_priority_group != (1uL << (RT_THREAD_PRIORITY_MAX - 1u))) {
+        return (OS_FALSE);                       /* A higher priority is ready                         */
+    }
+#endif
+    if (rt_list_len(&rt_thread_priority_table[RT_THREAD_PRIORITY_MAX - 1u]) != 1u) {
+        return (OS_FALSE);                       /* Another thread shares the idle priority            */
+    }
+    return (OS_TRUE);
+}
+
+/*
+*********************************************************************************************************
+*                                       COMPUTE THE IDLE TIME
+*
+* Description: This function computes how many ticks the tick may be stopped for.
+*
+* Arguments  : now       is the current tick.
+*
+*              next      is the tick at which the first RT-Thread timer expires, RT_TICK_MAX if none.
+*
+* Returns    : The number of ticks until 'next' (at most OS_TIME_DLY_MAX), or 0 if it is less than
+*              OS_TICKLESS_MIN_TICKS.
+*
+* Note(s)    : 1) 'next' may have wrapped around with respect to 'now', the difference is wraparound safe.
+*              2) A timer which is already due ('next' at or before 'now') gives 0.
+*********************************************************************************************************
+*/
+
+INT32U  OS_TicklessTicks (INT32U  now,
+                          INT32U  next)
+{
+    INT32U  ticks;
+
+
+    if (next == (INT32U)RT_TICK_MAX) {           /* No timer: sleep as long as RT-Thread allows        */
+        ticks = OS_TIME_DLY_MAX;
+    } else {
+        ticks = next - now;
+        if (ticks > OS_TIME_DLY_MAX) {           /* 'next' is in the past, the timer is due            */
+            return (0u);
+        }
+    }
+    if (ticks < OS_TICKLESS_MIN_TICKS) {         /* Not worth stopping the tick                        */
+        return (0u);
+    }
+    return (ticks);
+}
+
+
+/*
+*********************************************************************************************************
+*                                           TICKLESS IDLE
+*
+* Description: This function is called by OS_TaskIdle().  It stops the periodic tick until the first
+*              RT-Thread timer expires (or an interrupt occurs) and then brings the tick counter up to date
+*              in one shot.
+*
+* Arguments  : none
+*
+* Returns    : none
+*
+* Note(s)    : 1) OS_CPU_TicklessSleep() is called with interrupts disabled.  A pending interrupt still
+*                 wakes up the CPU, it is serviced once this function enables interrupts again, after the
+*                 tick counter has been updated.
+*              2) This function is INTERNAL to uC/OS-II and your application should not call it.
+*********************************************************************************************************
+*/
+
+void  OS_TicklessIdle (void)
+{
+    INT32U     ticks;
+    INT32U     slept;
+#if OS_CRITICAL_METHOD == 3u                     /* Allocate storage for CPU status register           */
+    OS_CPU_SR  cpu_sr = 0u;
+#endif
+
+
+    OS_ENTER_CRITICAL();
+    if (OS_TicklessIdleOnly() == OS_FALSE) {     /* Another thread is ready, keep the tick running     */
+        OS_EXIT_CRITICAL();
+        return;
+    }
+    ticks = OS_TicklessTicks((INT32U)rt_tick_get(), (INT32U)rt_timer_next_timeout_tick());
+    if (ticks == 0u) {
+        OS_EXIT_CRITICAL();
+        return;
+    }
+    slept = OS_CPU_TicklessSleep(ticks);         /* Stop the tick and sleep, at most 'ticks' ticks     */
+    if (slept > 0u) {
+        rt_tick_set(rt_tick_get() + slept);      /* Account for the ticks slept at once ...            */
+        rt_timer_check();                        /* ... and expire the timers now due                  */
+    }
+    OS_EXIT_CRITICAL();
+}
+
+#endif
@@ -36,6 +36,53 @@
 
 #include "ucos_ii.h"
 
+/*
+*********************************************************************************************************
+*                                           LOCAL CONSTANTS
+*********************************************************************************************************
+*/
+
+#define  OS_TIME_64_UPD_PERIOD  0x40000000uL               /* Refresh period of the 64-bit snapshot    */
+
+
+/*
+*********************************************************************************************************
+*                                           LOCAL VARIABLES
+*********************************************************************************************************
+*/
+
+#if OS_TIME_GET64_EN > 0u
+static  volatile  INT32U  OSTime64Seq;                     /* Sequence counter, odd while updating     */
+static  volatile  INT32U  OSTime64Hi;                      /* Upper 32 bits of the snapshot            */
+static  volatile  INT32U  OSTime64Lo;                      /* rt_tick_get() at the snapshot            */
+static  struct rt_timer   OSTime64Tmr;                     /* Refreshes the snapshot                   */
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                          LOCAL PROTOTYPES
+*********************************************************************************************************
+*/
+
+#if (OS_TIME_DLY_UNTIL_EN > 0u) || (OS_TIME_GET64_EN > 0u)
+static  void   OS_TimeDlyArm      (rt_thread_t  thread,
+                                   rt_tick_t    ticks);
+#endif
+
+#if OS_TIME_GET64_EN > 0u
+static  void   OS_Time64Upd       (void        *parameter);
+#endif
+
+#if OS_TIME_DLY_HMSM_EN > 0u
+static  INT8U  OS_TimeHMSMToTicks (INT8U    hours,
+                                   INT8U    minutes,
+                                   INT8U    seconds,
+                                   INT16U   ms,
+                                   INT32U  *pticks);
+#endif
+
+
 /*
 *********************************************************************************************************
 *                                        DELAY TASK 'n' TICKS
@@ -98,7 +145,8 @@ INT8U  OSTimeDlyHMSM (INT8U   hours,
                       INT8U   seconds,
                       INT16U  ms)
 {
-    INT32U ticks;
+    INT8U   err;
+    INT32U  ticks;
 
 
     if (OSIntNesting > 0u) {                     /* See if trying to call from an ISR                  */
@@ -107,36 +155,130 @@ INT8U  OSTimeDlyHMSM (INT8U   hours,
     if (OSLockNesting > 0u) {                    /* See if called with scheduler locked                */
         return (OS_ERR_SCHED_LOCKED);
     }
-#if OS_ARG_CHK_EN > 0u
-    if (hours == 0u) {
-        if (minutes == 0u) {
-            if (seconds == 0u) {
-                if (ms == 0u) {
-                    return (OS_ERR_TIME_ZERO_DLY);
-                }
-            }
-        }
+    err = OS_TimeHMSMToTicks(hours, minutes, seconds, ms, &ticks);
+    if (err != OS_ERR_NONE) {
+        return (err);
     }
-    if (minutes > 59u) {
-        return (OS_ERR_TIME_INVALID_MINUTES);    /* Validate arguments to be within range              */
+    OSTimeDly(ticks);
+    return (OS_ERR_NONE);
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                     DELAY TASK UNTIL AN ABSOLUTE TIME
+*
+* Description: This function delays the calling task until 'period' ticks after '*pwake', then advances
+*              '*pwake' by 'period'.  Called once per cycle, it releases the task on absolute tick
+*              boundaries: unlike OSTimeDly(), the time the task spends working does not add up.
+*
+* Arguments  : pwake     is a pointer to the tick of the previous wake up.  Initialize it with OSTimeGet()
+*                        before the first call, it is updated by this function.
+*
+*              period    is the number of ticks between two wake ups.
+*
+* Returns    : OS_ERR_NONE            if the task was delayed or, the wake up time had already passed.
+*              OS_ERR_PDATA_NULL      if 'pwake' is a NULL pointer.
+*              OS_ERR_TIME_ZERO_DLY   if 'period' is 0.
+*              OS_ERR_TIME_DLY_ISR    if you called this function from an ISR.
+*              OS_ERR_SCHED_LOCKED    if you called this function with the scheduler locked.
+*
+* Note(s)    : 1) The tick counter may wrap around between two calls, the wake up time is computed from
+*                 the elapsed number of ticks ('now - *pwake'), which is immune to the wraparound.
+*              2) If the wake up time has already passed (the task overran its period), the task is not
+*                 delayed and '*pwake' is still advanced by 'period', so the next calls catch up.
+*              3) The thread timer is armed with interrupts disabled right after reading the tick
+*                 counter, a tick can thus not slip in between (RT-Thread 3.1.3 has no
+*                 rt_thread_delay_until()).
+*********************************************************************************************************
+*/
+
+#if OS_TIME_DLY_UNTIL_EN > 0u
+INT8U  OSTimeDlyUntil (INT32U  *pwake,
+                       INT32U   period)
+{
+    INT32U       elapsed;
+    rt_tick_t    ticks;
+    rt_thread_t  thread;
+#if OS_CRITICAL_METHOD == 3u                     /* Allocate storage for CPU status register           */
+    OS_CPU_SR    cpu_sr = 0u;
+#endif
+
+
+    if (OSIntNesting > 0u) {                     /* See if trying to call from an ISR                  */
+        return (OS_ERR_TIME_DLY_ISR);
     }
-    if (seconds > 59u) {
-        return (OS_ERR_TIME_INVALID_SECONDS);
+    if (OSLockNesting > 0u) {                    /* See if called with scheduler locked                */
+        return (OS_ERR_SCHED_LOCKED);
     }
-    if (ms > 999u) {
-        return (OS_ERR_TIME_INVALID_MS);
+#if OS_ARG_CHK_EN > 0u
+    if (pwake == (INT32U *)0) {
+        return (OS_ERR_PDATA_NULL);
+    }
+    if (period == 0u) {
+        return (OS_ERR_TIME_ZERO_DLY);
     }
 #endif
-                                                 /* Compute the total number of clock ticks required.. */
-                                                 /* .. (rounded to the nearest tick)                   */
-    ticks = ((INT32U)hours * 3600uL + (INT32U)minutes * 60uL + (INT32U)seconds) * OS_TICKS_PER_SEC
-          + OS_TICKS_PER_SEC * ((INT32U)ms + 500uL / OS_TICKS_PER_SEC) / 1000uL;
-    OSTimeDly(ticks);
+    thread  = rt_thread_self();
+    OS_ENTER_CRITICAL();
+    elapsed = (INT32U)rt_tick_get() - *pwake;   /* Wraparound safe                                    */
+    *pwake += period;                            /* Next wake up                                       */
+    if (elapsed >= period) {                     /* Wake up time already passed                        */
+        OS_EXIT_CRITICAL();
+        return (OS_ERR_NONE);
+    }
+    ticks   = (rt_tick_t)(period - elapsed);
+    OS_TimeDlyArm(thread, ticks);                /* No window between reading the tick and arming      */
+    OS_EXIT_CRITICAL();
+    rt_schedule();
+    if (thread->error == -RT_ETIMEOUT) {
+        thread->error = RT_EOK;
+    }
     return (OS_ERR_NONE);
 }
 #endif
 
 
+/*
+*********************************************************************************************************
+*                               DELAY TASK UNTIL AN ABSOLUTE TIME (HMSM)
+*
+* Description: This function is identical to OSTimeDlyUntil() except that the period is specified in
+*              HOURS, MINUTES, SECONDS and MILLISECONDS.
+*
+* Arguments  : pwake     is a pointer to the tick of the previous wake up, see OSTimeDlyUntil().
+*              hours     specifies the number of hours of the period (max. is 255)
+*              minutes   specifies the number of minutes (max. 59)
+*              seconds   specifies the number of seconds (max. 59)
+*              ms        specifies the number of milliseconds (max. 999)
+*
+* Returns    : see OSTimeDlyUntil() and OSTimeDlyHMSM().
+*
+* Note(s)    : 1) The period is rounded to the nearest tick, as in OSTimeDlyHMSM().
+*********************************************************************************************************
+*/
+
+#if (OS_TIME_DLY_UNTIL_EN > 0u) && (OS_TIME_DLY_HMSM_EN > 0u)
+INT8U  OSTimeDlyUntilHMSM (INT32U  *pwake,
+                           INT8U    hours,
+                           INT8U    minutes,
+                           INT8U    seconds,
+                           INT16U   ms)
+{
+    INT8U   err;
+    INT32U  ticks;
+
+
+    err = OS_TimeHMSMToTicks(hours, minutes, seconds, ms, &ticks);
+    if (err != OS_ERR_NONE) {
+        return (err);
+    }
+    return (OSTimeDlyUntil(pwake, ticks));
+}
+#endif
+
+
 /*
 *********************************************************************************************************
 *                                        RESUME A DELAYED TASK
@@ -238,6 +380,357 @@ INT32U  OSTimeGet (void)
 #if OS_TIME_GET_SET_EN > 0u
 void  OSTimeSet (INT32U ticks)
 {
+#if OS_TIME_GET64_EN > 0u
+#if OS_CRITICAL_METHOD == 3u                     /* Allocate storage for CPU status register           */
+    OS_CPU_SR  cpu_sr = 0u;
+#endif
+
+
+    OS_ENTER_CRITICAL();
+    OSTime64Seq++;                               /* Restart the 64-bit time base from 'ticks'          */
     rt_tick_set(ticks);
+    OSTime64Hi = 0u;
+    OSTime64Lo = ticks;
+    OSTime64Seq++;
+    OS_EXIT_CRITICAL();
+#else
+    rt_tick_set(ticks);
+#endif
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                   CONVERT TIMESTAMP COUNTS TO TIME
+*
+* Description: These functions convert a number of timestamp counts, typically the difference between two
+*              OS_TS_GET() readings, to nanoseconds or microseconds.
+*
+* Arguments  : ts        is the number of timestamp counts.
+*
+* Returns    : The corresponding time (rounded down), or 0 if the frequency of the timestamp counter is
+*              unknown.
+*
+* Note(s)    : 1) The conversion uses a 64-bit division, convert the result of a measurement rather than
+*                 each reading.
+*              2) These functions can be called from an ISR.
+*********************************************************************************************************
+*/
+
+#if OS_TIME_TS_EN > 0u
+INT64U  OSTimeTSToNs (INT32U  ts)
+{
+    INT32U  freq;
+
+
+    freq = OS_TS_FREQ;
+    if (freq == 0u) {
+        return (0u);
+    }
+    return (((INT64U)ts * 1000000000uL) / freq);
+}
+
+
+INT64U  OSTimeTSToUs (INT32U  ts)
+{
+    INT32U  freq;
+
+
+    freq = OS_TS_FREQ;
+    if (freq == 0u) {
+        return (0u);
+    }
+    return (((INT64U)ts * 1000000uL) / freq);
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                    GET CURRENT SYSTEM TIME (64-BIT)
+*
+* Description: This function returns the number of clock ticks since startup (or since OSTimeSet()) as a
+*              64-bit value, which does not wrap around during the life of the product.
+*
+* Arguments  : none
+*
+* Returns    : The current value of the 64-bit tick counter.
+*
+* Note(s)    : 1) The upper 32 bits are taken from a snapshot that OS_Time64Upd() refreshes every
+*                 OS_TIME_64_UPD_PERIOD ticks.  The 32-bit tick counter wraps at most once between the
+*                 snapshot and now, which is detected by the tick being lower than the snapshot.
+*              2) The snapshot is read without disabling interrupts: the sequence counter is odd while the
+*                 snapshot is updated and changes with each update, the read is retried in both cases.
+*                 With RT_USING_SMP, the read is done in a critical section instead, since the other core
+*                 may observe the stores of the update out of order.
+*              3) This function can be called from an ISR.
+*********************************************************************************************************
+*/
+
+#if OS_TIME_GET64_EN > 0u
+INT64U  OSTimeGet64 (void)
+{
+    INT32U     hi;
+    INT32U     lo;
+    INT32U     tick;
+#ifdef RT_USING_SMP
+#if OS_CRITICAL_METHOD == 3u                     /* Allocate storage for CPU status register           */
+    OS_CPU_SR  cpu_sr = 0u;
+#endif
+
+
+    OS_ENTER_CRITICAL();
+    hi   = OSTime64Hi;
+    lo   = OSTime64Lo;
+    tick = (INT32U)rt_tick_get();
+    OS_EXIT_CRITICAL();
+#else
+    INT32U     seq;
+
+
+    do {
+        seq  = OSTime64Seq;
+        hi   = OSTime64Hi;
+        lo   = OSTime64Lo;
+        tick = (INT32U)rt_tick_get();
+    } while (((seq & 1u) != 0u) || (seq != OSTime64Seq));
+#endif
+    if (tick < lo) {                             /* 32-bit tick wrapped since the snapshot             */
+        hi++;
+    }
+    return (((INT64U)hi << 32) | (INT64U)tick);
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                   DELAY TASK UNTIL A 64-BIT TIME
+*
+* Description: This function delays the calling task until OSTimeGet64() reaches 'wake'.
+*
+* Arguments  : wake      is the tick (as returned by OSTimeGet64()) at which the task is to be woken up.
+*
+* Returns    : OS_ERR_NONE            if the task was delayed or, 'wake' had already passed.
+*              OS_ERR_TIME_DLY_ISR    if you called this function from an ISR.
+*              OS_ERR_SCHED_LOCKED    if you called this function with the scheduler locked.
+*
+* Note(s)    : 1) Delays longer than RT-Thread's maximum (RT_TICK_MAX / 2) are done in several steps.
+*              2) OSTimeDlyResume() only ends the current step, the task is delayed again until 'wake'.
+*********************************************************************************************************
+*/
+
+#if OS_TIME_GET64_EN > 0u
+INT8U  OSTimeDlyUntil64 (INT64U  wake)
+{
+    INT64U       now;
+    rt_tick_t    ticks;
+    rt_thread_t  thread;
+#if OS_CRITICAL_METHOD == 3u                     /* Allocate storage for CPU status register           */
+    OS_CPU_SR    cpu_sr = 0u;
+#endif
+
+
+    if (OSIntNesting > 0u) {                     /* See if trying to call from an ISR                  */
+        return (OS_ERR_TIME_DLY_ISR);
+    }
+    if (OSLockNesting > 0u) {                    /* See if called with scheduler locked                */
+        return (OS_ERR_SCHED_LOCKED);
+    }
+    thread = rt_thread_self();
+    for (;;) {
+        OS_ENTER_CRITICAL();
+        now = OSTimeGet64();
+        if (now >= wake) {
+            OS_EXIT_CRITICAL();
+            return (OS_ERR_NONE);
+        }
+        if ((wake - now) > (INT64U)OS_TIME_DLY_MAX) {
+            ticks = (rt_tick_t)OS_TIME_DLY_MAX;
+        } else {
+            ticks = (rt_tick_t)(wake - now);
+        }
+        OS_TimeDlyArm(thread, ticks);
+        OS_EXIT_CRITICAL();
+        rt_schedule();
+        if (thread->error == -RT_ETIMEOUT) {
+            thread->error = RT_EOK;
+        }
+    }
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                      DELAY TASK 'n' TICKS (64-BIT)
+*
+* Description: This function is identical to OSTimeDly() except that the delay is a 64-bit number of
+*              ticks, it is thus not limited by RT-Thread's maximum delay.
+*
+* Arguments  : ticks     is the time delay (in clock ticks).  0 means no delay.
+*
+* Returns    : none
+*********************************************************************************************************
+*/
+
+#if OS_TIME_GET64_EN > 0u
+void  OSTimeDly64 (INT64U  ticks)
+{
+    if (ticks > 0u) {                            /* 0 means no delay!                                  */
+        (void)OSTimeDlyUntil64(OSTimeGet64() + ticks);
+    }
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                 INITIALIZE THE 64-BIT TIME BASE
+*
+* Description: This function is called by OSInit() to take the first snapshot of the 64-bit time base and
+*              to start the timer that refreshes it.
+*
+* Arguments  : none
+*
+* Returns    : none
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*********************************************************************************************************
+*/
+
+#if OS_TIME_GET64_EN > 0u
+void  OS_Time64Init (void)
+{
+    OSTime64Seq = 0u;
+    OSTime64Hi  = 0u;
+    OSTime64Lo  = (INT32U)rt_tick_get();
+    rt_timer_init(&OSTime64Tmr, "uCOS-II Time64",
+                  OS_Time64Upd, RT_NULL, OS_TIME_64_UPD_PERIOD,
+                  RT_TIMER_FLAG_PERIODIC | RT_TIMER_FLAG_HARD_TIMER);
+    rt_timer_start(&OSTime64Tmr);
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                      ARM THE DELAY OF A THREAD
+*
+* Description: This function suspends 'thread' and arms its timer for 'ticks', as rt_thread_delay() does.
+*              The caller then enables interrupts and calls rt_schedule().
+*
+* Arguments  : thread    is the calling thread.
+*
+*              ticks     is the delay (in ticks), > 0 and <= OS_TIME_DLY_MAX.
+*
+* Returns    : none
+*
+* Note(s)    : 1) Interrupts MUST be disabled, so that the delay is counted from the tick the caller has
+*                 just read.
+*              2) This function is INTERNAL to uC/OS-II and your application should not call it.
+*********************************************************************************************************
+*/
+
+#if (OS_TIME_DLY_UNTIL_EN > 0u) || (OS_TIME_GET64_EN > 0u)
+static  void  OS_TimeDlyArm (rt_thread_t  thread,
+                             rt_tick_t    ticks)
+{
+    rt_thread_suspend(thread);
+    rt_timer_control(&thread->thread_timer, RT_TIMER_CTRL_SET_TIME, &ticks);
+    rt_timer_start(&thread->thread_timer);
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                   REFRESH THE 64-BIT TIME SNAPSHOT
+*
+* Description: This function is called every OS_TIME_64_UPD_PERIOD ticks (from the tick ISR) to take a new
+*              snapshot of the 64-bit time base.
+*
+* Arguments  : parameter  is not used.
+*
+* Returns    : none
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*********************************************************************************************************
+*/
+
+#if OS_TIME_GET64_EN > 0u
+static  void  OS_Time64Upd (void  *parameter)
+{
+    INT32U     tick;
+#if OS_CRITICAL_METHOD == 3u                     /* Allocate storage for CPU status register           */
+    OS_CPU_SR  cpu_sr = 0u;
+#endif
+
+
+    (void)parameter;
+    OS_ENTER_CRITICAL();
+    tick = (INT32U)rt_tick_get();
+    OSTime64Seq++;                               /* Odd: snapshot being updated                        */
+    if (tick < OSTime64Lo) {                     /* 32-bit tick wrapped since the last snapshot        */
+        OSTime64Hi++;
+    }
+    OSTime64Lo = tick;
+    OSTime64Seq++;                               /* Even: snapshot consistent                          */
+    OS_EXIT_CRITICAL();
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                    CONVERT HMSM TO A NUMBER OF TICKS
+*
+* Description: This function validates a delay specified in HOURS, MINUTES, SECONDS and MILLISECONDS and
+*              converts it to clock ticks (rounded to the nearest tick).
+*
+* Arguments  : hours .. ms  see OSTimeDlyHMSM().
+*
+*              pticks       receives the number of ticks.
+*
+* Returns    : OS_ERR_NONE, OS_ERR_TIME_ZERO_DLY, OS_ERR_TIME_INVALID_MINUTES, OS_ERR_TIME_INVALID_SECONDS or
+*              OS_ERR_TIME_INVALID_MS.
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*********************************************************************************************************
+*/
+
+#if OS_TIME_DLY_HMSM_EN > 0u
+static  INT8U  OS_TimeHMSMToTicks (INT8U    hours,
+                                   INT8U    minutes,
+                                   INT8U    seconds,
+                                   INT16U   ms,
+                                   INT32U  *pticks)
+{
+#if OS_ARG_CHK_EN > 0u
+    if (hours == 0u) {
+        if (minutes == 0u) {
+            if (seconds == 0u) {
+                if (ms == 0u) {
+                    return (OS_ERR_TIME_ZERO_DLY);
+                }
+            }
+        }
+    }
+    if (minutes > 59u) {
+        return (OS_ERR_TIME_INVALID_MINUTES);    /* Validate arguments to be within range              */
+    }
+    if (seconds > 59u) {
+        return (OS_ERR_TIME_INVALID_SECONDS);
+    }
+    if (ms > 999u) {
+        return (OS_ERR_TIME_INVALID_MS);
+    }
+#endif
+                                                 /* Compute the total number of clock ticks required.. */
+                                                 /* .. (rounded to the nearest tick)                   */
+    *pticks = ((INT32U)hours * 3600uL + (INT32U)minutes * 60uL + (INT32U)seconds) * OS_TICKS_PER_SEC
+            + OS_TICKS_PER_SEC * ((INT32U)ms + 500uL / OS_TICKS_PER_SEC) / 1000uL;
+    return (OS_ERR_NONE);
 }
 #endif
@@ -0,0 +1,476 @@
+/*
+ * Copyright (c) 2021, Meco Jianting Man <jiantingman@foxmail.com>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+/*
+*********************************************************************************************************
+*                                              uC/OS-II
+*                                        The Real-Time Kernel
+*
+*                    Copyright 1992-2020 Silicon Laboratories Inc. www.silabs.com
+*
+*                                 SPDX-License-Identifier: APACHE-2.0
+*
+*               This software is subject to an open source license and is distributed by
+*                Silicon Laboratories Inc. pursuant to the terms of the Apache License,
+*                    Version 2.0 available at www.apache.org/licenses/LICENSE-2.0.
+*
+*********************************************************************************************************
+*/
+
+
+/*
+*********************************************************************************************************
+*
+*                                   THREAD LOCAL STORAGE (TLS) MANAGEMENT
+*
+* Filename : os_tls.c
+* Version  : V2.93.00
+*********************************************************************************************************
+* Note(s)  : 1) Every task created with OSTaskCreateExt() (or OSTaskCreate()) owns OS_TLS_TBL_SIZE slots
+*               in its TCB (OSTCBTLSTbl[]).  A TLS ID is simply an index into this table, so reading or
+*               writing the current task's value is a single indexed access off its TCB.  Threads that
+*               were not created through uC/OS-II (main, idle, timer thread ...) have no TLS registers.
+*
+*            2) When OS_TLS_LIB_EN is set and the C library is newlib, one TLS ID is reserved by
+*               OS_TLS_Init() to hold a 'struct _reent' per task.  It is allocated once when the task is
+*               created, installed as '_impure_ptr' on every context switch (which gives each task its
+*               own errno, strtok() state, stdio buffers ...) and reclaimed by a TLS destructor when the
+*               task is deleted.  This requires RT_USING_HEAP and RT_USING_HOOK.  OS_TLS_LIB_EN is off
+*               by default: every task creation then allocates a 'struct _reent' (about 1 KB unless
+*               newlib is built with _REENT_SMALL), a hook runs on every context switch and a task whose
+*               context could not be allocated shares the global one.
+*********************************************************************************************************
+*/
+
+#include "ucos_ii.h"
+
+#if (OS_TASK_CREATE_EXT_EN > 0u) && defined(OS_TLS_TBL_SIZE) && (OS_TLS_TBL_SIZE > 0u)
+
+#if (OS_TLS_LIB_EN > 0u) && defined(RT_USING_HEAP) && defined(RT_USING_HOOK)
+#include <stdlib.h>                                     /* Pulls in <newlib.h> when using newlib        */
+#if defined(__NEWLIB__) && !defined(__PICOLIBC__)
+#include <reent.h>
+#define  OS_TLS_LIB_NEWLIB
+#endif
+#endif
+
+/*
+*********************************************************************************************************
+*                                            LOCAL VARIABLES
+*********************************************************************************************************
+*/
+
+static  OS_TLS_ID            OS_TLS_NextAvailID;                      /* Next available TLS ID           */
+static  OS_TLS_DESTRUCT_PTR  OS_TLS_DestructPtrTbl[OS_TLS_TBL_SIZE];   /* Destructor of each TLS ID       */
+
+#ifdef OS_TLS_LIB_NEWLIB
+static  OS_TLS_ID            OS_TLS_LibID;                            /* TLS ID holding 'struct _reent'  */
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                         C LIBRARY CONTEXT DESTRUCTOR
+*
+* Description: This function is the TLS destructor of the C library context of a task being deleted.
+*
+* Arguments  : ptcb     is a pointer to the OS_TCB of the task being deleted.
+*
+*              id       is the TLS ID reserved for the C library context.
+*
+*              value    is the task's 'struct _reent'.
+*
+* Returns    : none
+*********************************************************************************************************
+*/
+
+#ifdef OS_TLS_LIB_NEWLIB
+static  void  OS_TLS_LibDestruct (OS_TCB     *ptcb,
+                                  OS_TLS_ID   id,
+                                  OS_TLS      value)
+{
+    struct _reent  *preent;
+
+
+    (void)ptcb;
+    (void)id;
+    preent = (struct _reent *)value;
+    if (preent == _impure_ptr) {                        /* Task deleting itself, fall back to global ctx */
+        _impure_ptr = _GLOBAL_REENT;
+    }
+    _reclaim_reent(preent);
+    rt_free(preent);
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                        ALLOCATE THE NEXT AVAILABLE TLS ID
+*
+* Description: This function is called to obtain the ID of the next free TLS (Task Local Storage) register
+*
+* Arguments  : perr     is a pointer to a variable that will hold an error code related to this call.
+*
+*                           OS_ERR_NONE               if the call was successful
+*                           OS_ERR_TLS_NO_MORE_AVAIL  if you are attempting to assign more TLS than you
+*                                                     declared OS_TLS_TBL_SIZE.
+*
+* Returns    : The next available TLS 'id' or OS_TLS_TBL_SIZE if an error is detected.
+*********************************************************************************************************
+*/
+
+OS_TLS_ID  OS_TLS_GetID (INT8U  *perr)
+{
+    OS_TLS_ID  id;
+#if OS_CRITICAL_METHOD == 3u                            /* Allocate storage for CPU status register      */
+    OS_CPU_SR  cpu_sr = 0u;
+#endif
+
+
+
+    OS_ENTER_CRITICAL();
+    if (OS_TLS_NextAvailID >= OS_TLS_TBL_SIZE) {        /* See if we exceeded the number of IDs available*/
+        OS_EXIT_CRITICAL();
+       *perr = OS_ERR_TLS_NO_MORE_AVAIL;                /* Yes, cannot allocate more TLS                 */
+        return ((OS_TLS_ID)OS_TLS_TBL_SIZE);
+    }
+    id = OS_TLS_NextAvailID;                            /* Assign the next available ID                  */
+    OS_TLS_NextAvailID++;                               /* Increment available ID for next request       */
+    OS_EXIT_CRITICAL();
+   *perr = OS_ERR_NONE;
+    return (id);
+}
+
+
+/*
+*********************************************************************************************************
+*                                       GET THE CURRENT VALUE OF A TLS REGISTER
+*
+* Description: This function is called to obtain the current value of a TLS register
+*
+* Arguments  : ptcb     is a pointer to the OS_TCB of the task you want to read the TLS register from.  If
+*                       'ptcb' is a NULL pointer then you will get the TLS register of the current task.
+*
+*              id       is the 'id' of the desired TLS register.  Note that the 'id' must be less than
+*                       'OS_TLS_NextAvailID'
+*
+*              perr     is a pointer to a variable that will hold an error code related to this call.
+*
+*                           OS_ERR_NONE            if the call was successful
+*                           OS_ERR_TLS_ID_INVALID  if the 'id' is greater or equal to OS_TLS_NextAvailID
+*                           OS_ERR_TLS_NOT_EN      if the task was created by specifying that TLS support
+*                                                  was not needed for the task, or 'ptcb' is NULL and the
+*                                                  caller is not a uC/OS-II task (e.g. an RT-Thread thread)
+*
+* Returns    : The current value of the task's TLS register or 0 if an error is detected.
+*
+* Note(s)    : 1) Reading the current task's own register needs no critical section: nobody else writes it
+*                 and the access is a single aligned load.
+*********************************************************************************************************
+*/
+
+OS_TLS  OS_TLS_GetValue (OS_TCB     *ptcb,
+                         OS_TLS_ID   id,
+                         INT8U      *perr)
+{
+    OS_TLS     value;
+#if OS_CRITICAL_METHOD == 3u                            /* Allocate storage for CPU status register      */
+    OS_CPU_SR  cpu_sr = 0u;
+#endif
+
+
+
+    if (id >= OS_TLS_NextAvailID) {                     /* Caller must specify an ID that's been assigned*/
+       *perr = OS_ERR_TLS_ID_INVALID;
+        return ((OS_TLS)0);
+    }
+    if (ptcb == (OS_TCB *)0) {                          /* Does caller want to use current task's TCB?   */
+        ptcb = OS_TCBFromThread(rt_thread_self());      /* Yes, NULL if not a uC/OS-II task              */
+        if ((ptcb == (OS_TCB *)0) ||
+            ((ptcb->OSTCBOpt & OS_TASK_OPT_NO_TLS) != 0u)) {
+           *perr = OS_ERR_TLS_NOT_EN;
+            return ((OS_TLS)0);
+        }
+       *perr = OS_ERR_NONE;
+        return (ptcb->OSTCBTLSTbl[id]);
+    }
+    OS_ENTER_CRITICAL();
+    if ((ptcb->OSTCBOpt & OS_TASK_OPT_NO_TLS) != 0u) {  /* See if TLS is available for this task        */
+        OS_EXIT_CRITICAL();
+       *perr = OS_ERR_TLS_NOT_EN;                       /* Task specified that TLS was not allowed       */
+        return ((OS_TLS)0);
+    }
+    value = ptcb->OSTCBTLSTbl[id];
+    OS_EXIT_CRITICAL();
+   *perr = OS_ERR_NONE;
+    return (value);
+}
+
+
+/*
+*********************************************************************************************************
+*                                        INITIALIZE THE TASK LOCAL STORAGE SERVICES
+*
+* Description: This function is called by uC/OS-II to initialize the TLS id allocator.
+*
+*              This function also initializes an array containing function pointers.  There is one
+*              function associated to each task register and the function (assuming non-NULL) is called
+*              when the task is deleted.
+*
+* Arguments  : perr     is a pointer to a variable that will hold an error code related to this call.
+*
+*                           OS_ERR_NONE  if the call was successful
+*
+* Returns    : none
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*********************************************************************************************************
+*/
+
+void  OS_TLS_Init (INT8U  *perr)
+{
+    OS_TLS_ID  i;
+
+
+    OS_TLS_NextAvailID = 0u;
+    for (i = 0u; i < OS_TLS_TBL_SIZE; i++) {
+        OS_TLS_DestructPtrTbl[i] = (OS_TLS_DESTRUCT_PTR)0;
+    }
+#ifdef OS_TLS_LIB_NEWLIB
+    OS_TLS_LibID = OS_TLS_GetID(perr);                  /* Reserve a register for the C library context  */
+    if (*perr != OS_ERR_NONE) {
+        return;
+    }
+    OS_TLS_SetDestruct(OS_TLS_LibID, OS_TLS_LibDestruct, perr);
+#else
+   *perr = OS_ERR_NONE;
+#endif
+}
+
+
+/*
+*********************************************************************************************************
+*                                        SET THE CURRENT VALUE OF A TASK TLS REGISTER
+*
+* Description: This function is called to change the current value of a task TLS register.
+*
+* Arguments  : ptcb     is a pointer to the OS_TCB of the task you want to set the task's TLS register for.
+*                       If 'ptcb' is a NULL pointer then you are changing the register of the current task.
+*
+*              id       is the 'id' of the desired task TLS register.  Note that the 'id' must be less than
+*                       'OS_TLS_NextAvailID'
+*
+*              value    is the desired value for the task TLS register.
+*
+*              perr     is a pointer to a variable that will hold an error code related to this call.
+*
+*                           OS_ERR_NONE            if the call was successful
+*                           OS_ERR_TLS_ID_INVALID  if you specified an invalid TLS ID
+*                           OS_ERR_TLS_NOT_EN      if the task was created by specifying that TLS support
+*                                                  was not needed for the task, or 'ptcb' is NULL and the
+*                                                  caller is not a uC/OS-II task (e.g. an RT-Thread thread)
+*
+* Returns    : none
+*********************************************************************************************************
+*/
+
+void  OS_TLS_SetValue (OS_TCB     *ptcb,
+                       OS_TLS_ID   id,
+                       OS_TLS      value,
+                       INT8U      *perr)
+{
+#if OS_CRITICAL_METHOD == 3u                            /* Allocate storage for CPU status register      */
+    OS_CPU_SR  cpu_sr = 0u;
+#endif
+
+
+
+    if (id >= OS_TLS_NextAvailID) {                     /* Caller must specify an ID that's been assigned*/
+       *perr = OS_ERR_TLS_ID_INVALID;
+        return;
+    }
+    if (ptcb == (OS_TCB *)0) {                          /* Does caller want to use current task's TCB?   */
+        ptcb = OS_TCBFromThread(rt_thread_self());      /* Yes, single store into our own register       */
+        if ((ptcb == (OS_TCB *)0) ||                    /* Not a uC/OS-II task: no TLS registers         */
+            ((ptcb->OSTCBOpt & OS_TASK_OPT_NO_TLS) != 0u)) {
+           *perr = OS_ERR_TLS_NOT_EN;
+            return;
+        }
+        ptcb->OSTCBTLSTbl[id] = value;
+       *perr = OS_ERR_NONE;
+        return;
+    }
+    OS_ENTER_CRITICAL();
+    if ((ptcb->OSTCBOpt & OS_TASK_OPT_NO_TLS) != 0u) {  /* See if TLS is available for this task        */
+        OS_EXIT_CRITICAL();
+       *perr = OS_ERR_TLS_NOT_EN;                       /* Task specified that TLS was not allowed       */
+        return;
+    }
+    ptcb->OSTCBTLSTbl[id] = value;
+    OS_EXIT_CRITICAL();
+   *perr = OS_ERR_NONE;
+}
+
+
+/*
+*********************************************************************************************************
+*                                   ASSIGN A DESTRUCTOR FUNCTION TO A TLS REGISTER
+*
+* Description: This function is called to assign a destructor function to a specific TLS.  When a task is
+*              deleted, all the destructors are called for all the task's TLS for which there is a
+*              destructor function defined.  In other when a task is deleted, all the non-NULL functions
+*              present in OS_TLS_DestructPtrTbl[] will be called.
+*
+* Arguments  : id          is the ID of the TLS register to assign the destructor to
+*
+*              pdestruct   is a pointer to a destructor function you want to assign to the TLS register.
+*
+*              perr        is a pointer to a variable that will hold an error code related to this call.
+*
+*                              OS_ERR_NONE                   if the call was successful
+*                              OS_ERR_TLS_ID_INVALID         if you specified an invalid TLS ID
+*                              OS_ERR_TLS_DESTRUCT_ASSIGNED  if a destructor has already been assigned
+*
+* Returns    : none
+*********************************************************************************************************
+*/
+
+void  OS_TLS_SetDestruct (OS_TLS_ID            id,
+                          OS_TLS_DESTRUCT_PTR  pdestruct,
+                          INT8U               *perr)
+{
+#if OS_CRITICAL_METHOD == 3u                            /* Allocate storage for CPU status register      */
+    OS_CPU_SR  cpu_sr = 0u;
+#endif
+
+
+
+    if (id >= OS_TLS_NextAvailID) {                     /* See if we exceeded the number of TLS IDs      */
+       *perr = OS_ERR_TLS_ID_INVALID;
+        return;
+    }
+    OS_ENTER_CRITICAL();
+    if (OS_TLS_DestructPtrTbl[id] != (OS_TLS_DESTRUCT_PTR)0) { /* Can only assign a destructor once      */
+        OS_EXIT_CRITICAL();
+       *perr = OS_ERR_TLS_DESTRUCT_ASSIGNED;
+        return;
+    }
+    OS_TLS_DestructPtrTbl[id] = pdestruct;
+    OS_EXIT_CRITICAL();
+   *perr = OS_ERR_NONE;
+}
+
+
+/*
+*********************************************************************************************************
+*                                          TASK CREATE HOOK
+*
+* Description: This function is called by OS_TCBInit() when a task is created.  It allocates the task's C
+*              library context when OS_TLS_LIB_EN is set.
+*
+* Arguments  : ptcb     is a pointer to the OS_TCB of the task being created.
+*
+* Returns    : none
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*              2) OSTCBTLSTbl[] has already been cleared by OS_TCBInit().  If the C library context cannot be
+*                 allocated the task keeps using the global one.
+*********************************************************************************************************
+*/
+
+void  OS_TLS_TaskCreate (OS_TCB  *ptcb)
+{
+#ifdef OS_TLS_LIB_NEWLIB
+    struct _reent  *preent;
+
+
+    if ((ptcb->OSTCBOpt & OS_TASK_OPT_NO_TLS) != 0u) {
+        return;
+    }
+    preent = (struct _reent *)rt_malloc(sizeof(struct _reent));
+    if (preent != (struct _reent *)0) {
+        _REENT_INIT_PTR(preent);
+    }
+    ptcb->OSTCBTLSTbl[OS_TLS_LibID] = (OS_TLS)preent;
+#else
+    (void)ptcb;                                         /* Prevent compiler warning for not using 'ptcb' */
+#endif
+}
+
+
+/*
+*********************************************************************************************************
+*                                          TASK DELETE HOOK
+*
+* Description: This function is called by OSTaskDel() when a task is deleted.  It calls the destructor of
+*              every TLS register that holds a value.
+*
+* Arguments  : ptcb     is a pointer to the OS_TCB of the task being deleted.
+*
+* Returns    : none
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*********************************************************************************************************
+*/
+
+void  OS_TLS_TaskDel (OS_TCB  *ptcb)
+{
+    OS_TLS_ID            id;
+    OS_TLS_DESTRUCT_PTR  pdestruct;
+
+
+    if ((ptcb->OSTCBOpt & OS_TASK_OPT_NO_TLS) != 0u) {  /* See if TLS is available for this task        */
+        return;
+    }
+    for (id = 0u; id < OS_TLS_NextAvailID; id++) {      /* Call all the destructors associated with TLS  */
+        pdestruct = OS_TLS_DestructPtrTbl[id];
+        if ((pdestruct != (OS_TLS_DESTRUCT_PTR)0) &&
+            (ptcb->OSTCBTLSTbl[id] != (OS_TLS)0)) {
+            (*pdestruct)(ptcb, id, ptcb->OSTCBTLSTbl[id]);
+        }
+        ptcb->OSTCBTLSTbl[id] = (OS_TLS)0;
+    }
+}
+
+
+/*
+*********************************************************************************************************
+*                                          TASK SWITCH HOOK
+*
+* Description: This function is called by the context switch hook to install the C library context of the
+*              task being switched in.
+*
+* Arguments  : none
+*
+* Returns    : none
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*              2) RT-Thread has already made the incoming thread current, OSTCBCur is thus the task being
+*                 switched in.  Threads not created through uC/OS-II use the global C library context.
+*********************************************************************************************************
+*/
+
+void  OS_TLS_TaskSw (void)
+{
+#ifdef OS_TLS_LIB_NEWLIB
+    OS_TCB         *ptcb;
+    struct _reent  *preent;
+
+
+    preent = _GLOBAL_REENT;
+    ptcb   = OS_TCBFromThread(rt_thread_self());
+    if (ptcb != (OS_TCB *)0) {
+        if ((ptcb->OSTCBOpt & OS_TASK_OPT_NO_TLS) == 0u) {
+            if (ptcb->OSTCBTLSTbl[OS_TLS_LibID] != (OS_TLS)0) {
+                preent = (struct _reent *)ptcb->OSTCBTLSTbl[OS_TLS_LibID];
+            }
+        }
+    }
+    _impure_ptr = preent;
+#endif
+}
+
+#endif
@@ -105,6 +105,20 @@ extern "C" {
 
 #define  OS_TCB_RESERVED        ((OS_TCB *)1)
 
+#if OS_PRIO_MAP_EN > 0u                                 /* RT-Thread priority of a uC/OS-II priority   */
+#define  OS_PRIO_TO_RT(prio)    ((rt_uint8_t)OSPrioMapTbl[(prio)])
+#else
+#define  OS_PRIO_TO_RT(prio)    ((rt_uint8_t)(prio))
+#endif
+
+#define  OS_STK_FILL       ((OS_STK)(~(OS_STK)0 / 0xFFu * 0x23u))/* RT-Thread fill pattern ('#') per entry */
+#define  OS_STK_FREE_UNKNOWN  0xFFFFFFFFuL              /* OSTCBStkFree: watermark not measured yet    */
+
+#define  OS_TIME_DLY_MAX    (RT_TICK_MAX / 2u - 1u)     /* Longest delay/timeout RT-Thread accepts     */
+
+#define  OS_TS_GET()          OS_CPU_TS_TmrRd()         /* Read the free running timestamp counter     */
+#define  OS_TS_FREQ           OS_CPU_TS_TmrFreq()       /* Timestamp counts per second                 */
+
 /*
 *********************************************************************************************************
 *                             TASK STATUS (Bit definition for OSTCBStat)
@@ -164,6 +178,7 @@ extern "C" {
 
 
 #define  OS_FLAG_CONSUME             0x80u  /* Consume the flags if condition(s) satisfied             */
+#define  OS_FLAG_CB_INLINE           0x40u  /* Run flag callback from OSFlagPost() (must be ISR safe)  */
 
 
 #define  OS_FLAG_CLR                    0u
@@ -288,6 +303,12 @@ extern "C" {
 #define OS_ERR_TASK_SUSPEND_IDLE       71u
 #define OS_ERR_TASK_SUSPEND_PRIO       72u
 #define OS_ERR_TASK_WAITING            73u
+#define OS_ERR_TASK_STK_REG_FULL       74u
+#define OS_ERR_TASK_CPU_INVALID        75u
+#define OS_ERR_TASK_BUDGET_INVALID     76u
+#define OS_ERR_TASK_LITE_FULL          77u
+#define OS_ERR_TASK_POOL_FULL          78u
+#define OS_ERR_TASK_GRP_FULL           79u
 
 #define OS_ERR_TIME_NOT_DLY            80u
 #define OS_ERR_TIME_INVALID_MINUTES    81u
@@ -315,6 +336,8 @@ extern "C" {
 #define OS_ERR_FLAG_INVALID_OPT       113u
 #define OS_ERR_FLAG_GRP_DEPLETED      114u
 #define OS_ERR_FLAG_NAME_TOO_LONG     115u
+#define OS_ERR_FLAG_CB_DEPLETED       116u
+#define OS_ERR_FLAG_CB_NOT_FOUND      117u
 
 #define OS_ERR_PCP_LOWER              120u
 
@@ -341,6 +364,10 @@ extern "C" {
 #define OS_ERR_TLS_DESTRUCT_ASSIGNED  163u
 #define OS_ERR_OS_NOT_RUNNING         164u
 
+#define OS_ERR_TASK_PERIOD_INVALID    170u
+#define OS_ERR_TASK_NOT_PERIODIC      171u
+#define OS_ERR_TASK_STK_NOT_REG       172u
+
 
 /*
 *********************************************************************************************************
@@ -382,13 +409,70 @@ typedef struct os_event {
 */
 
 #if (OS_FLAG_EN > 0u)
-typedef  rt_uint32_t   OS_FLAGS;
+
+#if OS_FLAGS_NBITS == 8u                    /* Determine the size of OS_FLAGS (8, 16, 32 or 64 bits)   */
+typedef  INT8U    OS_FLAGS;
+#endif
+
+#if OS_FLAGS_NBITS == 16u
+typedef  INT16U   OS_FLAGS;
+#endif
+
+#if OS_FLAGS_NBITS == 32u
+typedef  INT32U   OS_FLAGS;
+#endif
+
+#if OS_FLAGS_NBITS == 64u
+typedef  INT64U   OS_FLAGS;
+#endif
+
 
 typedef struct os_flag_grp {                /* Event Flag Group                                        */
-    rt_event_t    pFlagGrp;                 /* rt-thread event                                         */
-    OS_FLAGS      OSFlagFlags;              /* 32 bit flags                                            */
+    INT8U         OSFlagType;               /* Should be set to OS_EVENT_TYPE_FLAG                     */
+    void         *OSFlagWaitList;           /* Pointer to first NODE of task waiting on event flag     */
+    OS_FLAGS      OSFlagFlags;              /* 8, 16, 32 or 64 bit flags                               */
+#if OS_FLAG_NAME_EN > 0u
+    INT8U        *OSFlagName;
+#endif
+#if OS_FLAG_CB_EN > 0u
+    void         *OSFlagCbList;             /* Pointer to first callback registered on the group       */
+#endif
 } OS_FLAG_GRP;
 
+
+
+typedef struct os_flag_node {               /* Event Flag Wait List Node                               */
+    void         *OSFlagNodeNext;           /* Pointer to next     NODE in wait list                   */
+    void         *OSFlagNodePrev;           /* Pointer to previous NODE in wait list                   */
+    void         *OSFlagNodeTCB;            /* Pointer to TCB of waiting task                          */
+    void         *OSFlagNodeFlagGrp;        /* Pointer to Event Flag Group (0 once unlinked)           */
+    OS_FLAGS      OSFlagNodeFlags;          /* Event flag to wait on                                   */
+    INT8U         OSFlagNodeWaitType;       /* Type of wait:                                           */
+                                            /*      OS_FLAG_WAIT_AND                                   */
+                                            /*      OS_FLAG_WAIT_ALL                                   */
+                                            /*      OS_FLAG_WAIT_OR                                    */
+                                            /*      OS_FLAG_WAIT_ANY                                   */
+    BOOLEAN       OSFlagNodeConsume;        /* Consume the flags when the node is readied              */
+    BOOLEAN       OSFlagNodeRdy;            /* This node's condition made the task ready               */
+} OS_FLAG_NODE;
+
+
+
+#if OS_FLAG_CB_EN > 0u
+typedef  void (*OS_FLAG_CALLBACK)(OS_FLAG_GRP *pgrp, OS_FLAGS flags_rdy, void *p_arg);
+
+typedef struct os_flag_cb {                 /* Event Flag Callback                                     */
+    struct os_flag_cb *OSFlagCbNext;        /* Pointer to next callback of the group (or free list)    */
+    struct os_flag_cb *OSFlagCbPendNext;    /* Pointer to next callback waiting for the callback task  */
+    OS_FLAG_GRP       *OSFlagCbGrp;         /* Pointer to Event Flag Group (0 if unused)               */
+    OS_FLAG_CALLBACK   OSFlagCbFnct;        /* Function to call when the condition is met              */
+    void              *OSFlagCbArg;         /* Argument to pass to function                            */
+    OS_FLAGS           OSFlagCbFlags;       /* Event flag(s) to watch                                  */
+    OS_FLAGS           OSFlagCbFlagsRdy;    /* Flags accumulated until the callback task runs          */
+    INT8U              OSFlagCbWaitType;    /* Type of wait, OS_FLAG_CONSUME and OS_FLAG_CB_INLINE     */
+    BOOLEAN            OSFlagCbPend;        /* Callback is queued for the callback task                */
+} OS_FLAG_CB;
+#endif
 #endif
 
 
@@ -505,6 +589,178 @@ typedef struct os_stk_data {
 #endif
 
 
+/*
+*********************************************************************************************************
+*                                            TASK SNAPSHOT
+*********************************************************************************************************
+*/
+
+#if OS_TASK_QUERY_EN > 0u
+typedef struct os_task_snapshot {
+    void    *OSPendObj;                     /* Event or event flag group the task is pending on        */
+    INT32U   OSStkSize;                     /* Size of task stack (in number of stack elements)        */
+    INT32U   OSStkUsed;                     /* Stack high-water mark (0 if not measured yet)           */
+    INT32U   OSCtxSwCtr;                    /* Number of times the task was switched in                */
+    INT8U    OSPrio;                        /* Task priority                                           */
+    INT8U    OSStat;                        /* Task      status (OS_STAT_xxx)                          */
+    INT8U    OSStatPend;                    /* Task PEND status (OS_STAT_PEND_xxx)                     */
+    INT8U    OSCPUUsage;                    /* CPU usage of the task over the last sample (in %)       */
+} OS_TASK_SNAPSHOT;
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                            TASK GROUP DATA
+*********************************************************************************************************
+*/
+
+#if OS_TASK_GRP_EN > 0u
+typedef struct os_task_grp {
+    INT8U    OSGrpNbr;                      /* Number of tasks in the group                            */
+    INT8U    OSGrpPrioTbl[OS_TASK_GRP_SIZE];/* Priorities of the tasks in the group                    */
+} OS_TASK_GRP;
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                      TASK CONFIGURATION TABLE DATA
+*********************************************************************************************************
+*/
+
+#if OS_TASK_CREATE_TBL_EN > 0u
+typedef struct os_task_cfg {
+    void               (*OSTaskCfgFnct)(void *p_arg);  /* Task code                                    */
+    void                *OSTaskCfgArg;      /* Argument passed to the task                             */
+    OS_STK              *OSTaskCfgStk;      /* Lowest memory location of the task's stack              */
+    INT32U               OSTaskCfgStkSize;  /* Size of the stack (in number of OS_STK elements)        */
+    INT8U                OSTaskCfgPrio;     /* Task priority                                           */
+    INT16U               OSTaskCfgId;       /* Task ID                                                 */
+    const char          *OSTaskCfgName;     /* Task name, NULL for the default name                    */
+    INT16U               OSTaskCfgOpt;      /* Task options, see OSTaskCreateExt()                     */
+} OS_TASK_CFG;
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                            TASK POOL DATA
+*********************************************************************************************************
+*/
+
+#if OS_TASK_POOL_EN > 0u
+typedef  void  (*OS_TASK_POOL_FNCT)(void *p_arg);
+
+typedef struct os_task_pool_job {
+    OS_TASK_POOL_FNCT    OSJobFnct;         /* Job function                                            */
+    void                *OSJobArg;          /* Argument passed to the job function                     */
+} OS_TASK_POOL_JOB;
+
+typedef struct os_task_pool {
+    struct rt_semaphore  OSPoolSem;         /* Counts the jobs not yet taken by a worker               */
+    OS_TASK_POOL_JOB    *OSPoolJobTbl;      /* Ring buffer of the jobs not yet taken by a worker       */
+    INT16U               OSPoolJobSize;     /* Size of the ring buffer (in number of jobs)             */
+    INT16U               OSPoolJobIn;       /* Index where the next job is inserted                    */
+    INT16U               OSPoolJobOut;      /* Index of the next job to run                            */
+    INT16U               OSPoolJobCnt;      /* Number of jobs in the ring buffer                       */
+    INT8U                OSPoolPrio;        /* Priority of the first worker                            */
+    INT8U                OSPoolNbr;         /* Number of workers                                       */
+} OS_TASK_POOL;
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                            LITE TASK DATA
+*********************************************************************************************************
+*/
+
+#if OS_TASK_LITE_EN > 0u
+#define  OS_LITE_WAITING                0u      /* Lite task returned while waiting                    */
+#define  OS_LITE_ENDED                  1u      /* Lite task has run to completion                     */
+
+typedef  struct os_lite  OS_LITE;
+
+typedef  INT8U  (*OS_LITE_FNCT)(OS_LITE *plite);
+
+struct os_lite {
+    OS_LITE_FNCT     OSLiteFnct;            /* Lite task function                                      */
+    void            *OSLiteArg;             /* Argument of the lite task                               */
+    OS_LITE         *OSLiteNext;            /* Next lite task run by the same dispatcher               */
+    void            *OSLiteEventPtr;        /* Object the lite task is waiting on                      */
+    void            *OSLiteMsg;             /* Message received                                        */
+    INT32U           OSLiteTickStart;       /* Tick at which the wait started                          */
+    INT32U           OSLiteTicks;           /* Delay or timeout of the wait (in ticks)                 */
+    INT16U           OSLiteLc;              /* Resume point (source line of the wait, 0 == start)      */
+    INT8U            OSLiteErr;             /* Result of the last wait                                 */
+    BOOLEAN          OSLiteRdy;             /* Lite task made progress during the last call            */
+};
+
+                                            /* Resume points are source lines: one wait per line!      */
+#define  OS_LITE_BEGIN(plite)           switch ((plite)->OSLiteLc) { case 0u:
+
+#define  OS_LITE_END(plite)             } (plite)->OSLiteLc = 0u; return (OS_LITE_ENDED)
+
+#define  OS_LITE_YIELD(plite)                                                                           \
+         do {                                                                                           \
+             (plite)->OSLiteRdy = OS_TRUE;                                                              \
+             (plite)->OSLiteLc  = (INT16U)__LINE__; return (OS_LITE_WAITING); case __LINE__:;           \
+         } while (0)
+
+#define  OS_LITE_WAIT_UNTIL(plite, cond)                                                                \
+         do {                                                                                           \
+             OS_LiteWaitStart((plite), (void *)0, 0u);                                                  \
+             (plite)->OSLiteLc = (INT16U)__LINE__; case __LINE__:                                       \
+             if (!(cond)) {                                                                             \
+                 return (OS_LITE_WAITING);                                                              \
+             }                                                                                          \
+             (plite)->OSLiteRdy = OS_TRUE;                                                              \
+         } while (0)
+
+#define  OS_LITE_DLY(plite, ticks)                                                                      \
+         do {                                                                                           \
+             OS_LiteWaitStart((plite), (void *)0, (ticks));                                             \
+             (plite)->OSLiteLc = (INT16U)__LINE__; case __LINE__:                                       \
+             if (OS_LiteDlyDone((plite)) == OS_FALSE) {                                                 \
+                 return (OS_LITE_WAITING);                                                              \
+             }                                                                                          \
+         } while (0)
+
+#define  OS_LITE_PEND_SEM(plite, pevent, timeout, perr)                                                 \
+         do {                                                                                           \
+             OS_LiteWaitStart((plite), (void *)(pevent), (timeout));                                    \
+             (plite)->OSLiteLc = (INT16U)__LINE__; case __LINE__:                                       \
+             if (OS_LitePendSem((plite)) == OS_FALSE) {                                                 \
+                 return (OS_LITE_WAITING);                                                              \
+             }                                                                                          \
+             *(perr) = (plite)->OSLiteErr;                                                              \
+         } while (0)
+
+#define  OS_LITE_PEND_MBOX(plite, pevent, timeout, pmsg, perr)                                          \
+         do {                                                                                           \
+             OS_LiteWaitStart((plite), (void *)(pevent), (timeout));                                    \
+             (plite)->OSLiteLc = (INT16U)__LINE__; case __LINE__:                                       \
+             if (OS_LitePendMbox((plite)) == OS_FALSE) {                                                \
+                 return (OS_LITE_WAITING);                                                              \
+             }                                                                                          \
+             (pmsg)  = (plite)->OSLiteMsg;                                                              \
+             *(perr) = (plite)->OSLiteErr;                                                              \
+         } while (0)
+
+#define  OS_LITE_PEND_Q(plite, pevent, timeout, pmsg, perr)                                             \
+         do {                                                                                           \
+             OS_LiteWaitStart((plite), (void *)(pevent), (timeout));                                    \
+             (plite)->OSLiteLc = (INT16U)__LINE__; case __LINE__:                                       \
+             if (OS_LitePendQ((plite)) == OS_FALSE) {                                                   \
+                 return (OS_LITE_WAITING);                                                              \
+             }                                                                                          \
+             (pmsg)  = (plite)->OSLiteMsg;                                                              \
+             *(perr) = (plite)->OSLiteErr;                                                              \
+         } while (0)
+#endif
+
+
 /*
 *********************************************************************************************************
 *                                         TASK CONTROL BLOCK
@@ -519,6 +775,7 @@ typedef struct os_tcb {
     void            *OSTCBExtPtr;           /* Pointer to user definable data for TCB extension        */
     OS_STK          *OSTCBStkBottom;        /* Pointer to bottom of stack                              */
     INT32U           OSTCBStkSize;          /* Size of task stack (in number of stack elements)        */
+    INT32U           OSTCBStkFree;          /* Free stack elements found by the last watermark scan    */
     INT16U           OSTCBOpt;              /* Task options as passed by OSTaskCreateExt()             */
     INT16U           OSTCBId;               /* Task ID (0..65535)                                      */
 #endif
@@ -532,12 +789,15 @@ typedef struct os_tcb {
 #endif
 #endif
 
+#if (OS_FLAG_EN > 0u)
+    OS_FLAG_NODE    *OSTCBFlagNode;         /* Pointer to event flag node (first of an array)          */
+    INT8U            OSTCBFlagNodeCnt;      /* Number of event flag nodes the task is waiting on       */
+    OS_FLAGS         OSTCBFlagsRdy;         /* Event flags that made task ready to run                 */
+#endif
+
 #ifndef PKG_USING_UCOSII_WRAPPER_TINY
 #if (OS_EVENT_EN)
     OS_EVENT        *OSTCBEventPtr;         /* Pointer to           event control block                */
-#endif
-#if (OS_FLAG_EN > 0u)
-    OS_FLAGS         OSTCBFlagsRdy;         /* Event flags that made task ready to run                 */
 #endif
     INT32U           OSTCBDly;              /* Nbr ticks to delay task or, timeout waiting for event   */
 #endif
@@ -550,10 +810,33 @@ typedef struct os_tcb {
 #endif
 
 #if OS_TASK_PROFILE_EN > 0u
+    INT32U           OSTCBCtxSwCtr;         /* Number of time the task was switched in                 */
+    INT32U           OSTCBCyclesTot;        /* Total run time of the task (in timestamp counts)        */
+    INT32U           OSTCBCyclesStart;      /* Timestamp at start of task resumption                   */
+    INT32U           OSTCBCyclesPrev;       /* OSTCBCyclesTot at previous statistic task sample        */
+    INT8U            OSTCBCPUUsage;         /* CPU usage of the task over the last sample (in %)       */
     OS_STK          *OSTCBStkBase;          /* Pointer to the beginning of the task stack              */
     INT32U           OSTCBStkUsed;          /* Number of bytes used from the stack                     */
 #endif
 
+#if OS_TASK_BUDGET_EN > 0u
+    INT32U           OSTCBBudget;           /* Ticks the task may run per period (0 == no budget)      */
+    INT32U           OSTCBBudgetLeft;       /* Ticks left in the current period                        */
+    INT32U           OSTCBBudgetPeriod;     /* Replenishment period (in ticks)                         */
+    INT32U           OSTCBBudgetPeriodLeft; /* Ticks until the next replenishment                      */
+    INT32U           OSTCBBudgetOvrCtr;     /* Number of times the task exhausted its budget           */
+    BOOLEAN          OSTCBBudgetThrottled;  /* Task is suspended until its budget is replenished       */
+#endif
+
+#if OS_TASK_PERIODIC_EN > 0u
+    INT32U           OSTCBPeriod;           /* Release period (in ticks, 0 == not periodic)            */
+    INT32U           OSTCBDeadline;         /* Deadline relative to each release (in ticks)            */
+    INT32U           OSTCBRelease;          /* Tick of the current release                             */
+    INT32U           OSTCBReleaseCtr;       /* Number of releases                                      */
+    INT32U           OSTCBDeadlineMissCtr;  /* Number of cycles that completed after their deadline    */
+    INT32U           OSTCBRespTimeMax;      /* Worst response time seen (in ticks)                     */
+#endif
+
 #if OS_TASK_NAME_EN > 0u
     INT8U           *OSTCBTaskName;
 #endif
@@ -624,13 +907,23 @@ OS_EXT  INT32U            OSIdleCtrMax;             /* Max. value that idle ctr
 OS_EXT  INT32U            OSIdleCtrRun;             /* Val. reached by idle ctr at run time in 1 sec.  */
 OS_EXT  BOOLEAN           OSStatRdy;                /* Flag indicating that the statistic task is rdy  */
 OS_EXT  OS_STK            OSTaskStatStk[OS_TASK_STAT_STK_SIZE];      /* Statistics task stack          */
+#ifdef RT_USING_SMP
+OS_EXT  INT8U             OSCPUUsageCore[RT_CPUS_NR];    /* Percentage of each core used               */
+OS_EXT  INT32U            OSIdleCtrMaxCore[RT_CPUS_NR];  /* Max. value of each core's idle counter     */
+OS_EXT  volatile  INT32U  OSIdleCtrCore[RT_CPUS_NR];     /* Idle counter of each core                  */
+#endif
 #endif
 
 #define OSIntNesting      rt_interrupt_get_nest()   /* Interrupt nesting level                         */
 
 #define OSLockNesting     rt_critical_level()       /* Multitasking lock nesting level                 */
 
+#if OS_PRIO_MAP_EN > 0u
+#define OSPrioCur OS_PrioCur()                             /* Priority of current task                 */
+OS_EXT  INT8U             OSPrioMapTbl[OS_LOWEST_PRIO + 1u];    /* RT-Thread priority of each priority */
+#else
 #define OSPrioCur rt_thread_self()->current_priority       /* Priority of current task                 */
+#endif
 
 OS_EXT  BOOLEAN           OSRunning;                       /* Flag indicating that kernel is running   */
 
@@ -650,6 +943,12 @@ OS_EXT  OS_TCB           *OSTCBList;                       /* Pointer to doubly
 OS_EXT  OS_TCB           *OSTCBPrioTbl[OS_LOWEST_PRIO + 1u];    /* Table of pointers to created TCBs   */
 OS_EXT  OS_TCB            OSTCBTbl[OS_MAX_TASKS + OS_N_SYS_TASKS];   /* Table of TCBs                  */
 
+#if (OS_FLAG_EN > 0u) && (OS_FLAG_CB_EN > 0u)
+OS_EXT  OS_FLAG_CB        OSFlagCbTbl[OS_FLAG_CB_MAX];     /* Table containing event flag callbacks    */
+OS_EXT  OS_FLAG_CB       *OSFlagCbFreeList;                /* Pointer to free list of flag callbacks   */
+OS_EXT  OS_STK            OSFlagCbTaskStk[OS_FLAG_CB_TASK_STK_SIZE]; /* Flag callback task stack       */
+#endif
+
 #if (OS_MEM_EN > 0u) && (OS_MAX_MEM_PART > 0u)
 OS_EXT  OS_MEM           *OSMemFreeList;            /* Pointer to free list of memory partitions       */
 OS_EXT  OS_MEM            OSMemTbl[OS_MAX_MEM_PART];/* Storage for memory partition manager            */
@@ -754,6 +1053,18 @@ OS_FLAGS      OSFlagAccept            (OS_FLAG_GRP     *pgrp,
                                        INT8U           *perr);
 #endif
 
+#if OS_FLAG_CB_EN > 0u
+INT8U         OSFlagCallbackRegister  (OS_FLAG_GRP     *pgrp,
+                                       OS_FLAGS         flags,
+                                       INT8U            wait_type,
+                                       OS_FLAG_CALLBACK fnct,
+                                       void            *p_arg);
+
+INT8U         OSFlagCallbackUnregister(OS_FLAG_GRP     *pgrp,
+                                       OS_FLAG_CALLBACK fnct,
+                                       void            *p_arg);
+#endif
+
 OS_FLAG_GRP  *OSFlagCreate            (OS_FLAGS         flags,
                                        INT8U           *perr);
 
@@ -779,6 +1090,16 @@ OS_FLAGS      OSFlagPend              (OS_FLAG_GRP     *pgrp,
                                        INT32U           timeout,
                                        INT8U           *perr);
 
+#if OS_FLAG_PEND_MULTI_EN > 0u
+OS_FLAGS      OSFlagPendMulti         (OS_FLAG_GRP    **pgrps,
+                                       OS_FLAGS        *pflags,
+                                       INT8U           *pwait_types,
+                                       INT8U            n,
+                                       INT32U           timeout,
+                                       INT8U           *pwhich,
+                                       INT8U           *perr);
+#endif
+
 OS_FLAGS      OSFlagPendGetFlagsRdy   (void);
 OS_FLAGS      OSFlagPost              (OS_FLAG_GRP     *pgrp,
                                        OS_FLAGS         flags,
@@ -1027,11 +1348,77 @@ INT8U         OSTaskChangePrio        (INT8U            oldprio,
                                        INT8U            newprio);
 #endif
 
+#if OS_TASK_AFFINITY_EN > 0u
+INT8U         OSTaskAffinitySet       (INT8U            prio,
+                                       INT32U           cpu_mask);
+#endif
+
+#if OS_TASK_LITE_EN > 0u
+INT8U         OSTaskCreateLite        (OS_LITE         *plite,
+                                       OS_LITE_FNCT     fnct,
+                                       void            *p_arg,
+                                       INT8U            prio);
+
+BOOLEAN       OS_LiteDlyDone          (OS_LITE         *plite);
+
+#if (OS_MBOX_EN > 0u) && (OS_MBOX_ACCEPT_EN > 0u)
+BOOLEAN       OS_LitePendMbox         (OS_LITE         *plite);
+#endif
+
+#if (OS_Q_EN > 0u) && (OS_Q_ACCEPT_EN > 0u)
+BOOLEAN       OS_LitePendQ            (OS_LITE         *plite);
+#endif
+
+#if (OS_SEM_EN > 0u) && (OS_SEM_ACCEPT_EN > 0u)
+BOOLEAN       OS_LitePendSem          (OS_LITE         *plite);
+#endif
+
+void          OS_LiteWaitStart        (OS_LITE         *plite,
+                                       void            *pevent,
+                                       INT32U           ticks);
+#endif
+
+#if OS_TASK_GRP_EN > 0u
+INT8U         OSTaskGroupAdd          (OS_TASK_GRP     *pgrp,
+                                       INT8U            prio);
+
+INT8U         OSTaskGroupCreate       (OS_TASK_GRP     *pgrp);
+
+INT8U         OSTaskGroupResume       (OS_TASK_GRP     *pgrp);
+
+INT8U         OSTaskGroupSuspend      (OS_TASK_GRP     *pgrp);
+#endif
+
+#if OS_TASK_POOL_EN > 0u
+INT8U         OSTaskPoolCreate        (OS_TASK_POOL    *ppool,
+                                       INT8U            prio,
+                                       INT8U            nbr,
+                                       OS_STK          *pstk,
+                                       INT32U           stk_size,
+                                       OS_TASK_POOL_JOB *pjob,
+                                       INT16U           job_size);
+
+INT8U         OSTaskPoolRun           (OS_TASK_POOL    *ppool,
+                                       OS_TASK_POOL_FNCT fnct,
+                                       void            *p_arg);
+#endif
+
+#if OS_TASK_BUDGET_EN > 0u
+INT8U         OSTaskBudgetSet         (INT8U            prio,
+                                       INT32U           budget_ticks,
+                                       INT32U           period_ticks);
+#endif
+
 #if OS_TASK_CREATE_EN > 0u
 INT8U         OSTaskCreate            (void           (*task)(void *p_arg),
                                        void            *p_arg,
                                        OS_STK          *ptos,
                                        INT8U            prio);
+
+#if OS_TASK_STK_REG_MAX > 0u
+INT8U         OSTaskStkRegister       (OS_STK          *pstk,
+                                       INT32U           stk_size);
+#endif
 #endif
 
 #if OS_TASK_CREATE_EXT_EN > 0u
@@ -1044,6 +1431,24 @@ INT8U         OSTaskCreateExt         (void           (*task)(void *p_arg),
                                        INT32U           stk_size,
                                        void            *pext,
                                        INT16U           opt);
+
+#if OS_TASK_TIME_SLICE_EN > 0u
+INT8U         OSTaskCreateExt2        (void           (*task)(void *p_arg),
+                                       void            *p_arg,
+                                       OS_STK          *ptos,
+                                       INT8U            prio,
+                                       INT16U           id,
+                                       OS_STK          *pbos,
+                                       INT32U           stk_size,
+                                       void            *pext,
+                                       INT16U           opt,
+                                       INT32U           time_slice);
+#endif
+#endif
+
+#if OS_TASK_CREATE_TBL_EN > 0u
+INT8U         OSTaskCreateTable       (const OS_TASK_CFG *ptbl,
+                                       INT8U            nbr);
 #endif
 
 #if OS_TASK_DEL_EN > 0u
@@ -1061,6 +1466,14 @@ void          OSTaskNameSet           (INT8U            prio,
                                        INT8U           *perr);
 #endif
 
+#if OS_TASK_PERIODIC_EN > 0u
+INT8U         OSTaskPeriodSet         (INT8U            prio,
+                                       INT32U           period,
+                                       INT32U           deadline);
+
+INT8U         OSTaskWaitNextPeriod    (void);
+#endif
+
 #if OS_TASK_SUSPEND_EN > 0u
 INT8U         OSTaskResume            (INT8U            prio);
 INT8U         OSTaskSuspend           (INT8U            prio);
@@ -1074,10 +1487,18 @@ INT8U         OSTaskStkChk            (INT8U            prio,
 #if OS_TASK_QUERY_EN > 0u
 INT8U         OSTaskQuery             (INT8U            prio,
                                        OS_TCB          *p_task_data);
+
+INT8U         OSTaskQueryAll          (OS_TASK_SNAPSHOT *p_snap,
+                                       INT8U            max);
 #endif
 
 
 
+#if OS_TASK_TIME_SLICE_EN > 0u
+INT8U         OSTaskTimeSliceSet      (INT8U            prio,
+                                       INT32U           time_slice);
+#endif
+
 #if OS_TASK_REG_TBL_SIZE > 0u
 INT32U        OSTaskRegGet            (INT8U            prio,
                                        INT8U            id,
@@ -1111,11 +1532,136 @@ INT8U         OSTimeDlyHMSM           (INT8U            hours,
 INT8U         OSTimeDlyResume         (INT8U            prio);
 #endif
 
+#if OS_TIME_DLY_UNTIL_EN > 0u
+INT8U         OSTimeDlyUntil          (INT32U          *pwake,
+                                       INT32U           period);
+
+#if OS_TIME_DLY_HMSM_EN > 0u
+INT8U         OSTimeDlyUntilHMSM      (INT32U          *pwake,
+                                       INT8U            hours,
+                                       INT8U            minutes,
+                                       INT8U            seconds,
+                                       INT16U           ms);
+#endif
+#endif
+
 #if OS_TIME_GET_SET_EN > 0u
 INT32U        OSTimeGet               (void);
 void          OSTimeSet               (INT32U           ticks);
 #endif
 
+#if OS_TIME_TS_EN > 0u
+INT64U        OSTimeTSToNs            (INT32U           ts);
+INT64U        OSTimeTSToUs            (INT32U           ts);
+#endif
+
+#if OS_TIME_GET64_EN > 0u
+void          OSTimeDly64             (INT64U           ticks);
+
+INT8U         OSTimeDlyUntil64        (INT64U           wake);
+
+INT64U        OSTimeGet64             (void);
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                  MILLISECOND AND MICROSECOND TIMEOUTS
+*
+* Description: OS_MsToTicks() and OS_UsToTicks() convert a time to clock ticks, rounded UP so that a delay
+*              or a timeout never falls short, and saturated to OS_TIME_DLY_MAX instead of overflowing.
+*              A time of 0 gives 0 ticks (i.e. no delay, or wait forever for the OSxxxPendMs() macros,
+*              as with the tick based functions).
+*
+*              The tick rate is known at compile time: when 1000 (or 1000000) is a multiple of the tick
+*              rate, or the tick rate a multiple of 1000, the conversion only divides or multiplies by a
+*              constant.  These functions are inline, so with a constant argument the whole conversion
+*              is done by the compiler.
+*
+*              OSTimeDlyMs(), OSTimeDlyUs(), OSxxxPendMs() are the tick based functions with their time
+*              argument converted this way.
+*********************************************************************************************************
+*/
+
+#if OS_TIME_MS_EN > 0u
+rt_inline  INT32U  OS_MsToTicks (INT32U  ms)
+{
+    INT32U  ticks;
+
+
+#if   (1000uL % OS_TICKS_PER_SEC) == 0uL                    /* e.g. 100, 1000 Hz: 'ms' per tick        */
+    ticks = ms / (1000uL / OS_TICKS_PER_SEC);
+    if ((ms % (1000uL / OS_TICKS_PER_SEC)) != 0uL) {
+        ticks++;
+    }
+#elif (OS_TICKS_PER_SEC % 1000uL) == 0uL                    /* e.g. 10000 Hz: ticks per 'ms'           */
+    if (ms > OS_TIME_DLY_MAX / (OS_TICKS_PER_SEC / 1000uL)) {
+        return (OS_TIME_DLY_MAX);
+    }
+    ticks = ms * (OS_TICKS_PER_SEC / 1000uL);
+#else                                                       /* Any other rate                          */
+    INT64U  ticks64;
+
+
+    ticks64 = ((INT64U)ms * OS_TICKS_PER_SEC + 999uL) / 1000uL;
+    if (ticks64 > OS_TIME_DLY_MAX) {
+        return (OS_TIME_DLY_MAX);
+    }
+    ticks = (INT32U)ticks64;
+#endif
+    if (ticks > OS_TIME_DLY_MAX) {
+        ticks = OS_TIME_DLY_MAX;
+    }
+    return (ticks);
+}
+
+
+rt_inline  INT32U  OS_UsToTicks (INT32U  us)
+{
+    INT32U  ticks;
+
+
+#if   (1000000uL % OS_TICKS_PER_SEC) == 0uL                 /* 'us' per tick                           */
+    ticks = us / (1000000uL / OS_TICKS_PER_SEC);
+    if ((us % (1000000uL / OS_TICKS_PER_SEC)) != 0uL) {
+        ticks++;
+    }
+#else
+    INT64U  ticks64;
+
+
+    ticks64 = ((INT64U)us * OS_TICKS_PER_SEC + 999999uL) / 1000000uL;
+    if (ticks64 > OS_TIME_DLY_MAX) {
+        return (OS_TIME_DLY_MAX);
+    }
+    ticks = (INT32U)ticks64;
+#endif
+    if (ticks > OS_TIME_DLY_MAX) {
+        ticks = OS_TIME_DLY_MAX;
+    }
+    return (ticks);
+}
+
+#define  OSTimeDlyMs(ms)                         OSTimeDly(OS_MsToTicks(ms))
+#define  OSTimeDlyUs(us)                         OSTimeDly(OS_UsToTicks(us))
+
+#if OS_FLAG_EN > 0u
+#define  OSFlagPendMs(pgrp, flags, wait_type, ms, perr)  OSFlagPend((pgrp), (flags), (wait_type), OS_MsToTicks(ms), (perr))
+#endif
+#if OS_MBOX_EN > 0u
+#define  OSMboxPendMs(pevent, ms, perr)          OSMboxPend((pevent), OS_MsToTicks(ms), (perr))
+#endif
+#if OS_MUTEX_EN > 0u
+#define  OSMutexPendMs(pevent, ms, perr)         OSMutexPend((pevent), OS_MsToTicks(ms), (perr))
+#endif
+#if OS_Q_EN > 0u
+#define  OSQPendMs(pevent, ms, perr)             OSQPend((pevent), OS_MsToTicks(ms), (perr))
+#endif
+#if OS_SEM_EN > 0u
+#define  OSSemPendMs(pevent, ms, perr)           OSSemPend((pevent), OS_MsToTicks(ms), (perr))
+#endif
+#endif
+
 void          OSTimeTick              (void);
 
 /*
@@ -1192,6 +1738,11 @@ INT16U        OSVersion               (void);
 *********************************************************************************************************
 */
 
+#if (OS_FLAG_EN > 0u)
+void          OS_FlagInit             (void);
+void          OS_FlagUnlink           (OS_FLAG_NODE    *pnode);
+#endif
+
 void          OS_MemClr               (INT8U           *pdest,
                                        INT16U           size);
 
@@ -1205,6 +1756,30 @@ void          OS_MemInit              (void);
 
 void          OS_Sched                (void);
 
+#if OS_TASK_BUDGET_EN > 0u
+void          OS_TaskBudgetInit       (void);
+#endif
+
+#if OS_TASK_LITE_EN > 0u
+void          OS_LiteInit             (void);
+#endif
+
+#if OS_TICKLESS_EN > 0u
+void          OS_TicklessIdle         (void);
+INT32U        OS_TicklessTicks        (INT32U           now,
+                                       INT32U           next);
+#endif
+
+#if OS_TIME_GET64_EN > 0u
+void          OS_Time64Init           (void);
+#endif
+
+OS_TCB       *OS_TCBFromThread        (struct rt_thread *thread);
+
+#if OS_PRIO_MAP_EN > 0u
+INT8U         OS_PrioCur              (void);
+#endif
+
 #if (OS_EVENT_NAME_EN > 0u) || (OS_FLAG_NAME_EN > 0u) || (OS_MEM_NAME_EN > 0u) || (OS_TASK_NAME_EN > 0u)
 INT8U         OS_StrLen               (INT8U           *psrc);
 #endif
@@ -1242,13 +1817,26 @@ void          OSInitHookEnd           (void);
 void          OSTaskCreateHook        (OS_TCB          *ptcb);
 void          OSTaskDelHook           (OS_TCB          *ptcb);
 
+#if OS_TASK_PERIODIC_EN > 0u
+void          OSTaskDeadlineMissHook  (OS_TCB          *ptcb);
+#endif
+
 #if OS_TASK_STAT_EN > 0u
 void          OSTaskIdleHook          (void);
 void          OSTaskStatHook          (void);
 #endif
 
+#if OS_TASK_SW_HOOK_EN > 0u
+void          OSTaskSwHook            (OS_TCB          *ptcb_cur,
+                                       OS_TCB          *ptcb_high_rdy);
+#endif
+
 void          OSTCBInitHook           (OS_TCB          *ptcb);
 
+#if OS_TIME_TICK_HOOK_EN > 0u
+void          OSTimeTickHook          (void);
+#endif
+
 
 
 /*
@@ -1261,11 +1849,21 @@ void          OSTCBInitHook           (OS_TCB          *ptcb);
 #if OS_APP_HOOKS_EN > 0u
 void          App_TaskCreateHook      (OS_TCB          *ptcb);
 void          App_TaskDelHook         (OS_TCB          *ptcb);
+#if OS_TASK_PERIODIC_EN > 0u
+void          App_TaskDeadlineMissHook(OS_TCB          *ptcb);
+#endif
 #if OS_TASK_STAT_EN > 0u
 void          App_TaskIdleHook        (void);
 void          App_TaskStatHook        (void);
 #endif
+#if OS_TASK_SW_HOOK_EN > 0u
+void          App_TaskSwHook          (OS_TCB          *ptcb_cur,
+                                       OS_TCB          *ptcb_high_rdy);
+#endif
 void          App_TCBInitHook         (OS_TCB          *ptcb);
+#if OS_TIME_TICK_HOOK_EN > 0u
+void          App_TimeTickHook        (void);
+#endif
 #endif
 
 
@@ -1329,6 +1927,52 @@ rt_err_t      rt_mq_send_all            (rt_mq_t mq, void *buffer, rt_size_t siz
     #ifndef OS_FLAG_QUERY_EN
     #error  "OS_CFG.H, Missing OS_FLAG_QUERY_EN: Include code for OSFlagQuery()"
     #endif
+
+    #ifndef OS_FLAG_PEND_MULTI_EN
+    #error  "OS_CFG.H, Missing OS_FLAG_PEND_MULTI_EN: Include code for OSFlagPendMulti()"
+    #else
+        #if OS_FLAG_PEND_MULTI_EN > 0u
+            #ifndef OS_FLAG_MULTI_MAX
+            #error  "OS_CFG.H, Missing OS_FLAG_MULTI_MAX: Max. number of groups OSFlagPendMulti() can wait on"
+            #else
+                #if (OS_FLAG_MULTI_MAX < 1u) || (OS_FLAG_MULTI_MAX > 255u)
+                #error  "OS_CFG.H, OS_FLAG_MULTI_MAX must be between 1 and 255"
+                #endif
+            #endif
+        #endif
+    #endif
+
+    #ifndef OS_FLAG_CB_EN
+    #error  "OS_CFG.H, Missing OS_FLAG_CB_EN: Include code for OSFlagCallbackRegister()"
+    #else
+        #if OS_FLAG_CB_EN > 0u
+            #ifndef OS_FLAG_CB_MAX
+            #error  "OS_CFG.H, Missing OS_FLAG_CB_MAX: Max. number of event flag callbacks"
+            #else
+                #if OS_FLAG_CB_MAX == 0u
+                #error  "OS_CFG.H, OS_FLAG_CB_MAX must be > 0"
+                #endif
+            #endif
+            #ifndef OS_FLAG_CB_TASK_PRIO
+            #error  "OS_CFG.H, Missing OS_FLAG_CB_TASK_PRIO: Priority of the deferred flag callback task"
+            #else
+                #if OS_FLAG_CB_TASK_PRIO >= (OS_LOWEST_PRIO - 1u)
+                #error  "OS_CFG.H, OS_FLAG_CB_TASK_PRIO must be < OS_LOWEST_PRIO - 1 (the statistic task priority)"
+                #endif
+            #endif
+            #ifndef OS_FLAG_CB_TASK_STK_SIZE
+            #error  "OS_CFG.H, Missing OS_FLAG_CB_TASK_STK_SIZE: Deferred flag callback task stack size"
+            #endif
+        #endif
+    #endif
+
+    #ifndef OS_FLAGS_NBITS
+    #error  "OS_CFG.H, Missing OS_FLAGS_NBITS: Size in #bits of OS_FLAGS data type (8, 16, 32 or 64)"
+    #else
+        #if (OS_FLAGS_NBITS != 8u) && (OS_FLAGS_NBITS != 16u) && (OS_FLAGS_NBITS != 32u) && (OS_FLAGS_NBITS != 64u)
+        #error  "OS_CFG.H, OS_FLAGS_NBITS must be 8, 16, 32 or 64"
+        #endif
+    #endif
 #endif
 
 /*
@@ -1509,6 +2153,14 @@ rt_err_t      rt_mq_send_all            (rt_mq_t mq, void *buffer, rt_size_t siz
 #error  "OS_CFG.H,         OS_LOWEST_PRIO must be <= 254 in V2.8x and higher"
 #endif
 
+#ifndef OS_PRIO_MAP_EN
+#error  "OS_CFG.H, Missing OS_PRIO_MAP_EN: Map uC/OS-II priorities onto RT-Thread priorities"
+#else
+    #if (OS_PRIO_MAP_EN == 0u) && (OS_LOWEST_PRIO != RT_THREAD_PRIORITY_MAX)
+    #error  "OS_CFG.H,         OS_LOWEST_PRIO must be RT_THREAD_PRIORITY_MAX when OS_PRIO_MAP_EN is 0"
+    #endif
+#endif
+
 #ifndef OS_TASK_STAT_EN
 #error  "OS_CFG.H, Missing OS_TASK_STAT_EN: Enable (1) or Disable(0) the statistics task"
 #endif
@@ -1521,12 +2173,28 @@ rt_err_t      rt_mq_send_all            (rt_mq_t mq, void *buffer, rt_size_t siz
 #error  "OS_CFG.H, Missing OS_TASK_STAT_STK_CHK_EN: Check task stacks from statistics task"
 #endif
 
+#ifndef OS_TASK_STK_CHK_WINDOW
+#error  "OS_CFG.H, Missing OS_TASK_STK_CHK_WINDOW: # of stack entries scanned by OSTaskStkChk()"
+#endif
+
 #ifndef OS_TASK_CHANGE_PRIO_EN
 #error  "OS_CFG.H, Missing OS_TASK_CHANGE_PRIO_EN: Include code for OSTaskChangePrio()"
 #endif
 
 #ifndef OS_TASK_CREATE_EN
 #error  "OS_CFG.H, Missing OS_TASK_CREATE_EN: Include code for OSTaskCreate()"
+#else
+    #if OS_TASK_CREATE_EN > 0u
+        #ifndef OS_TASK_CREATE_STK_SIZE
+        #error  "OS_CFG.H, Missing OS_TASK_CREATE_STK_SIZE: Stack size assumed by OSTaskCreate()"
+        #endif
+        #ifndef OS_TASK_STK_REG_MAX
+        #error  "OS_CFG.H, Missing OS_TASK_STK_REG_MAX: Max. number of stacks registered with OSTaskStkRegister()"
+        #endif
+        #if (OS_TASK_CREATE_STK_SIZE == 0u) && (OS_TASK_STK_REG_MAX == 0u)
+        #error  "OS_CFG.H, OS_TASK_STK_REG_MAX must be > 0 when OS_TASK_CREATE_STK_SIZE is 0"
+        #endif
+    #endif
 #endif
 
 #ifndef OS_TASK_CREATE_EXT_EN
@@ -1537,10 +2205,87 @@ rt_err_t      rt_mq_send_all            (rt_mq_t mq, void *buffer, rt_size_t siz
     #endif
 #endif
 
+#ifndef OS_TASK_AFFINITY_EN
+#error  "OS_CFG.H, Missing OS_TASK_AFFINITY_EN: Include code for OSTaskAffinitySet()"
+#else
+    #if (OS_TASK_AFFINITY_EN > 0u) && !defined(RT_USING_SMP)
+    #error  "OS_CFG.H,         OS_TASK_AFFINITY_EN requires RT_USING_SMP"
+    #endif
+#endif
+
+#ifndef OS_TASK_BUDGET_EN
+#error  "OS_CFG.H, Missing OS_TASK_BUDGET_EN: Include code for OSTaskBudgetSet()"
+#endif
+
 #ifndef OS_TASK_DEL_EN
 #error  "OS_CFG.H, Missing OS_TASK_DEL_EN: Include code for OSTaskDel()"
 #endif
 
+#ifndef OS_TASK_GRP_EN
+#error  "OS_CFG.H, Missing OS_TASK_GRP_EN: Include code for OSTaskGroupXxx()"
+#else
+    #if     OS_TASK_GRP_EN > 0u
+        #if     (OS_TASK_SUSPEND_EN == 0u) || (OS_SCHED_LOCK_EN == 0u)
+        #error  "OS_CFG.H,         OS_TASK_GRP_EN requires OS_TASK_SUSPEND_EN and OS_SCHED_LOCK_EN"
+        #endif
+        #ifndef OS_TASK_GRP_SIZE
+        #error  "OS_CFG.H, Missing OS_TASK_GRP_SIZE: Max. number of tasks in a task group"
+        #elif   (OS_TASK_GRP_SIZE == 0u) || (OS_TASK_GRP_SIZE > 255u)
+        #error  "OS_CFG.H,         OS_TASK_GRP_SIZE must be > 0 and <= 255"
+        #endif
+    #endif
+#endif
+
+#ifndef OS_TASK_PERIODIC_EN
+#error  "OS_CFG.H, Missing OS_TASK_PERIODIC_EN: Include code for OSTaskPeriodSet() and OSTaskWaitNextPeriod()"
+#endif
+
+#ifndef OS_TASK_POOL_EN
+#error  "OS_CFG.H, Missing OS_TASK_POOL_EN: Include code for OSTaskPoolCreate() and OSTaskPoolRun()"
+#else
+    #if (OS_TASK_POOL_EN > 0u) && (OS_TASK_CREATE_EXT_EN == 0u)
+    #error  "OS_CFG.H,         OS_TASK_POOL_EN requires OS_TASK_CREATE_EXT_EN"
+    #endif
+#endif
+
+#ifndef OS_TASK_LITE_EN
+#error  "OS_CFG.H, Missing OS_TASK_LITE_EN: Include code for OSTaskCreateLite()"
+#else
+    #if     OS_TASK_LITE_EN > 0u
+        #if     OS_TASK_CREATE_EXT_EN == 0u
+        #error  "OS_CFG.H,         OS_TASK_LITE_EN requires OS_TASK_CREATE_EXT_EN"
+        #endif
+        #ifndef OS_TASK_LITE_DISP_MAX
+        #error  "OS_CFG.H, Missing OS_TASK_LITE_DISP_MAX: Max. number of priorities running lite tasks"
+        #elif   OS_TASK_LITE_DISP_MAX == 0u
+        #error  "OS_CFG.H,         OS_TASK_LITE_DISP_MAX must be > 0"
+        #endif
+        #ifndef OS_TASK_LITE_STK_SIZE
+        #error  "OS_CFG.H, Missing OS_TASK_LITE_STK_SIZE: Lite task dispatcher stack size"
+        #endif
+    #endif
+#endif
+
+#ifndef OS_TASK_CREATE_TBL_EN
+#error  "OS_CFG.H, Missing OS_TASK_CREATE_TBL_EN: Include code for OSTaskCreateTable()"
+#else
+    #if (OS_TASK_CREATE_TBL_EN > 0u) && (OS_TASK_CREATE_EXT_EN == 0u)
+    #error  "OS_CFG.H,         OS_TASK_CREATE_TBL_EN requires OS_TASK_CREATE_EXT_EN"
+    #endif
+#endif
+
+#ifndef OS_TASK_TIME_SLICE_EN
+#error  "OS_CFG.H, Missing OS_TASK_TIME_SLICE_EN: Include code for OSTaskCreateExt2() and OSTaskTimeSliceSet()"
+#endif
+
+#ifndef OS_TASK_TIME_SLICE_DFLT
+#error  "OS_CFG.H, Missing OS_TASK_TIME_SLICE_DFLT: Default round-robin time slice of a task (in ticks)"
+#else
+    #if     OS_TASK_TIME_SLICE_DFLT == 0u
+    #error  "OS_CFG.H,         OS_TASK_TIME_SLICE_DFLT must be > 0"
+    #endif
+#endif
+
 #ifndef OS_TASK_NAME_EN
 #error  "OS_CFG.H, Missing OS_TASK_NAME_EN: Enable task names"
 #endif
@@ -1579,6 +2324,22 @@ rt_err_t      rt_mq_send_all            (rt_mq_t mq, void *buffer, rt_size_t siz
 #error  "OS_CFG.H, Missing OS_TIME_DLY_RESUME_EN: Include code for OSTimeDlyResume()"
 #endif
 
+#ifndef OS_TIME_MS_EN
+#error  "OS_CFG.H, Missing OS_TIME_MS_EN: Include OSTimeDlyMs(), OSTimeDlyUs() and OSxxxPendMs()"
+#endif
+
+#ifndef OS_TIME_TS_EN
+#error  "OS_CFG.H, Missing OS_TIME_TS_EN: Include code for OSTimeTSToNs() and OSTimeTSToUs()"
+#endif
+
+#ifndef OS_TIME_GET64_EN
+#error  "OS_CFG.H, Missing OS_TIME_GET64_EN: Include code for OSTimeGet64(), OSTimeDly64() and OSTimeDlyUntil64()"
+#endif
+
+#ifndef OS_TIME_DLY_UNTIL_EN
+#error  "OS_CFG.H, Missing OS_TIME_DLY_UNTIL_EN: Include code for OSTimeDlyUntil()"
+#endif
+
 #ifndef OS_TIME_GET_SET_EN
 #error  "OS_CFG.H, Missing OS_TIME_GET_SET_EN: Include code for OSTimeGet() and OSTimeSet()"
 #endif
@@ -1637,6 +2398,29 @@ rt_err_t      rt_mq_send_all            (rt_mq_t mq, void *buffer, rt_size_t siz
 #error  "OS_CFG.H, Missing OS_SCHED_LOCK_EN: Include code for OSSchedLock() and OSSchedUnlock()"
 #endif
 
+#ifndef OS_TICKLESS_EN
+#error  "OS_CFG.H, Missing OS_TICKLESS_EN: Stop the tick while idle"
+#else
+    #if     OS_TICKLESS_EN > 0u
+        #if     OS_TASK_STAT_EN == 0u
+        #error  "OS_CFG.H,         OS_TICKLESS_EN requires OS_TASK_STAT_EN (idle hook)"
+        #endif
+        #ifdef  RT_USING_SMP
+        #error  "OS_CFG.H,         OS_TICKLESS_EN is not supported with RT_USING_SMP"
+        #endif
+        #if     (OS_CPU_HOOKS_EN > 0u) && (OS_TIME_TICK_HOOK_EN > 0u)
+        #error  "OS_CFG.H,         OS_TICKLESS_EN requires OS_TIME_TICK_HOOK_EN == 0 (hook needs every tick)"
+        #endif
+        #ifndef OS_TICKLESS_MIN_TICKS
+        #error  "OS_CFG.H, Missing OS_TICKLESS_MIN_TICKS: Min. idle time worth stopping the tick for"
+        #endif
+    #endif
+#endif
+
+#ifndef OS_START_DEFER_EN
+#error  "OS_CFG.H, Missing OS_START_DEFER_EN: Tasks created before OSStart() are started by OSStart()"
+#endif
+
 
 #ifndef OS_EVENT_MULTI_EN
 #error  "OS_CFG.H, Missing OS_EVENT_MULTI_EN: Include code for OSEventPendMulti()"
@@ -1652,6 +2436,16 @@ rt_err_t      rt_mq_send_all            (rt_mq_t mq, void *buffer, rt_size_t siz
 #error  "OS_CFG.H, Missing OS_TASK_SW_HOOK_EN: Allows you to include the code for OSTaskSwHook() or not"
 #endif
 
+#if defined(OS_TLS_TBL_SIZE) && (OS_TLS_TBL_SIZE > 0u)
+#ifndef OS_TLS_LIB_EN
+#error  "OS_CFG.H, Missing OS_TLS_LIB_EN: Keep a C library context per task in a TLS register"
+#endif
+#endif
+
+#ifndef OS_TIME_TICK_HOOK_EN
+#error  "OS_CFG.H, Missing OS_TIME_TICK_HOOK_EN: Allows you to include the code for OSTimeTickHook() or not"
+#endif
+
 
 /*
 *********************************************************************************************************